@@ -0,0 +1,57 @@
+// Instantiates byte_span with many element types and extents through every
+// constructor, to measure the front-end cost of byte_span.hpp. Only compiled
+// with -fsyntax-only by measure.cmake; never linked.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "byte_span/byte_span.hpp"
+
+#if !defined(EXTENTS)
+#define EXTENTS 32
+#endif
+
+namespace {
+
+struct pod {
+  std::int32_t a;
+  float b;
+};
+
+template <typename T, size_t N>
+auto touch() -> size_t {
+  static std::array<T, N> array{};
+  static T c_array[N]{};  // NOLINT
+  static std::vector<T> vector(N);
+
+  size_t total = 0;
+  total += range3::byte_span{array}.size();
+  total += range3::byte_span{c_array}.size();
+  total += range3::byte_span{vector}.size();
+  total += range3::byte_span{std::span{array}}.size();
+  total += range3::byte_span{vector.begin(), vector.end()}.size();
+  total += range3::byte_span<const std::byte>{array.data(), N}.size();
+  total += range3::byte_span<const std::byte, N * sizeof(T)>{array}.size();
+  total += range3::cbyte_view{range3::byte_span{array}}.size();
+  return total;
+}
+
+template <typename T, size_t... N>
+auto touch_all(std::index_sequence<N...> /*extents*/) -> size_t {
+  return (touch<T, N + 1>() + ...);
+}
+
+}  // namespace
+
+auto instantiate() -> size_t {
+  constexpr auto extents = std::make_index_sequence<EXTENTS>{};
+  return touch_all<char>(extents) + touch_all<unsigned char>(extents)
+       + touch_all<std::byte>(extents) + touch_all<std::int16_t>(extents)
+       + touch_all<std::uint32_t>(extents) + touch_all<std::int64_t>(extents)
+       + touch_all<float>(extents) + touch_all<double>(extents)
+       + touch_all<pod>(extents) + touch_all<char32_t>(extents);
+}
@@ -0,0 +1,74 @@
+# Reports the front-end time of byte_span.hpp: COMPILER runs with
+# -fsyntax-only on a file that only includes the header, then on
+# instantiate.cpp, REPEAT times each, and the best time of each is printed.
+# With OUTPUT set, the results are also written there as JSON.
+#
+# Usage: cmake -D COMPILER=... -D INCLUDE_DIRS=... [-D REPEAT=5]
+#              [-D EXTENTS=32] [-D FLAGS=...] [-D OUTPUT=...]
+#              -P measure.cmake
+
+if(CMAKE_VERSION VERSION_LESS "3.23")
+  message(FATAL_ERROR "Timing needs CMake 3.23 or newer")
+endif()
+
+foreach(var IN ITEMS COMPILER INCLUDE_DIRS)
+  if(NOT DEFINED "${var}")
+    message(FATAL_ERROR "${var} is not defined")
+  endif()
+endforeach()
+if(NOT DEFINED REPEAT)
+  set(REPEAT 5)
+endif()
+if(NOT DEFINED EXTENTS)
+  set(EXTENTS 32)
+endif()
+
+set(include_flags "")
+foreach(dir IN LISTS INCLUDE_DIRS)
+  list(APPEND include_flags "-I${dir}")
+endforeach()
+
+# Sets `out` to the best wall time in milliseconds of compiling `source`.
+function(best_time out source)
+  set(best "")
+  foreach(i RANGE 1 "${REPEAT}")
+    string(TIMESTAMP start "%s%f")
+    execute_process(
+        COMMAND "${COMPILER}" -std=c++20 -fsyntax-only ${FLAGS}
+        ${include_flags} "-DEXTENTS=${EXTENTS}" "${source}"
+        RESULT_VARIABLE result
+        ERROR_VARIABLE error
+    )
+    string(TIMESTAMP stop "%s%f")
+    if(NOT result EQUAL "0")
+      message(FATAL_ERROR "Compiling ${source} failed:\n${error}")
+    endif()
+    math(EXPR elapsed "(${stop} - ${start}) / 1000")
+    if(best STREQUAL "" OR elapsed LESS best)
+      set(best "${elapsed}")
+    endif()
+  endforeach()
+  set("${out}" "${best}" PARENT_SCOPE)
+endfunction()
+
+get_filename_component(here "${CMAKE_CURRENT_LIST_FILE}" DIRECTORY)
+set(header_only "${CMAKE_CURRENT_BINARY_DIR}/byte_span_header_only.cpp")
+file(WRITE "${header_only}" "#include \"byte_span/byte_span.hpp\"\n")
+
+best_time(header_ms "${header_only}")
+best_time(instantiate_ms "${here}/instantiate.cpp")
+
+message(STATUS "byte_span.hpp alone:              ${header_ms} ms")
+message(STATUS "instantiate.cpp (${EXTENTS} extents): ${instantiate_ms} ms")
+
+if(DEFINED OUTPUT)
+  file(
+      WRITE "${OUTPUT}"
+      "{\n"
+      "  \"compiler\": \"${COMPILER}\",\n"
+      "  \"extents\": ${EXTENTS},\n"
+      "  \"header_ms\": ${header_ms},\n"
+      "  \"instantiate_ms\": ${instantiate_ms}\n"
+      "}\n"
+  )
+endif()
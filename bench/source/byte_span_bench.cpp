@@ -0,0 +1,169 @@
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "byte_span/byte_span.hpp"
+
+// byte_span against raw pointers and std::span. The "zero overhead" claim
+// holds when every byte_span row matches its raw and std_span rows.
+
+namespace {
+
+// A pointer and a length, the baseline every view is compared against.
+struct raw_view {
+  const std::byte* data;
+  size_t size;
+};
+
+using std_span = std::span<const std::byte>;
+using range3::cbyte_view;
+
+// One buffer shared by all benchmarks, grown on demand.
+auto buffer(size_t size) -> const std::byte* {
+  static std::vector<std::byte> storage;
+  if (storage.size() < size) {
+    storage.resize(size, std::byte{1});
+  }
+  return storage.data();
+}
+
+// 8 B to 1 GiB
+void sizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(8)->Range(8, int64_t{1} << 30);
+}
+
+template <typename View>
+auto make(const std::byte* p, size_t n) -> View {
+  if constexpr (std::is_same_v<View, raw_view>) {
+    return {p, n};
+  } else {
+    return View{p, n};
+  }
+}
+
+template <typename View>
+auto sum_of(View view) -> unsigned {
+  unsigned sum = 0;
+  if constexpr (std::is_same_v<View, raw_view>) {
+    for (size_t i = 0; i < view.size; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      sum += std::to_integer<unsigned>(view.data[i]);
+    }
+  } else {
+    for (auto const b : view) {
+      sum += std::to_integer<unsigned>(b);
+    }
+  }
+  return sum;
+}
+
+template <typename View>
+void construct(benchmark::State& state) {
+  auto const n = static_cast<size_t>(state.range(0));
+  const auto* p = buffer(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p);
+    auto view = make<View>(p, n);
+    benchmark::DoNotOptimize(view);
+  }
+}
+
+template <typename View>
+void subspan(benchmark::State& state) {
+  auto const n = static_cast<size_t>(state.range(0));
+  auto view = make<View>(buffer(n), n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view);
+    if constexpr (std::is_same_v<View, raw_view>) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      auto sub = raw_view{view.data + (n / 4), n / 2};
+      benchmark::DoNotOptimize(sub);
+    } else {
+      auto sub = view.subspan(n / 4, n / 2);
+      benchmark::DoNotOptimize(sub);
+    }
+  }
+}
+
+template <typename View>
+void iterate(benchmark::State& state) {
+  auto const n = static_cast<size_t>(state.range(0));
+  auto view = make<View>(buffer(n), n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view);
+    benchmark::DoNotOptimize(sum_of(view));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Static extents: the size is a template argument and the loop bound a
+// constant, against the same sizes as run-time values.
+template <typename View, size_t N>
+void iterate_static(benchmark::State& state) {
+  View view{buffer(N), N};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view);
+    benchmark::DoNotOptimize(sum_of(view));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(N));
+}
+
+// Reading the bytes as an array of uint32_t
+void as_span_raw(benchmark::State& state) {
+  auto const n = static_cast<size_t>(state.range(0));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto* p = reinterpret_cast<const std::uint32_t*>(buffer(n));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p);
+    std::uint32_t sum = 0;
+    for (size_t i = 0; i < n / 4; ++i) {
+      sum += p[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void as_span_byte_span(benchmark::State& state) {
+  auto const n = static_cast<size_t>(state.range(0));
+  auto view = cbyte_view{buffer(n), n};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view);
+    std::uint32_t sum = 0;
+    for (auto const v : range3::as_span<std::uint32_t>(view)) {
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(construct, raw_view)->Apply(sizes);
+BENCHMARK_TEMPLATE(construct, std_span)->Apply(sizes);
+BENCHMARK_TEMPLATE(construct, cbyte_view)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(subspan, raw_view)->Apply(sizes);
+BENCHMARK_TEMPLATE(subspan, std_span)->Apply(sizes);
+BENCHMARK_TEMPLATE(subspan, cbyte_view)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(iterate, raw_view)->Apply(sizes);
+BENCHMARK_TEMPLATE(iterate, std_span)->Apply(sizes);
+BENCHMARK_TEMPLATE(iterate, cbyte_view)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(iterate_static, std::span<const std::byte, 64>, 64);
+BENCHMARK_TEMPLATE(iterate_static, range3::byte_span<const std::byte, 64>, 64);
+BENCHMARK_TEMPLATE(iterate_static, cbyte_view, 64);
+BENCHMARK_TEMPLATE(iterate_static, std::span<const std::byte, 4096>, 4096);
+BENCHMARK_TEMPLATE(iterate_static,
+                   range3::byte_span<const std::byte, 4096>,
+                   4096);
+BENCHMARK_TEMPLATE(iterate_static, cbyte_view, 4096);
+
+BENCHMARK(as_span_raw)->Apply(sizes);
+BENCHMARK(as_span_byte_span)->Apply(sizes);
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "byte_span/byte_span.hpp"
+
+namespace range3 {
+
+// Whether `p` is a multiple of Align
+template <size_t Align>
+  requires(std::has_single_bit(Align))
+[[nodiscard]]
+inline auto is_aligned(const void* p) noexcept -> bool {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return (reinterpret_cast<std::uintptr_t>(p) & (Align - 1)) == 0;
+}
+
+template <size_t Align, typename B, size_t N>
+  requires(std::has_single_bit(Align))
+[[nodiscard]]
+inline auto is_aligned(byte_span<B, N> bytes) noexcept -> bool {
+  return is_aligned<Align>(static_cast<const void*>(bytes.data()));
+}
+
+namespace detail {
+
+// Alignment still guaranteed `offset` bytes past an `align`-aligned address:
+// the lowest set bit of the offset, capped at `align`.
+constexpr auto offset_alignment(size_t align, size_t offset) noexcept
+    -> size_t {
+  return offset == 0 ? align : std::min(align, offset & (~offset + 1));
+}
+
+}  // namespace detail
+
+// A byte_span whose data() is known to be aligned to `Align` bytes. It is a
+// byte_span, so it converts implicitly to one and works with every function
+// taking one; data() additionally tells the compiler about the alignment
+// through std::assume_aligned.
+//
+// Building one from a plain byte span, or from a weaker alignment, is
+// explicit and asserts the alignment. first() keeps the alignment, and
+// subspan<Offset>() keeps as much of it as Offset allows.
+template <typename B, size_t Extent = dynamic_extent, size_t Align = 64>
+class aligned_byte_span : public byte_span<B, Extent> {
+  static_assert(std::has_single_bit(Align), "alignment must be a power of 2");
+
+  using base = byte_span<B, Extent>;
+
+  template <typename, size_t, size_t>
+  friend class aligned_byte_span;
+
+ public:
+  using typename base::element_type;
+  using typename base::pointer;
+  using typename base::size_type;
+
+  static constexpr size_t alignment = Align;
+
+  constexpr aligned_byte_span() noexcept = default;
+
+  // Anything byte_span<B, Extent> can be constructed from; the alignment is
+  // asserted.
+  template <typename... Args>
+    requires(sizeof...(Args) != 0) && std::constructible_from<base, Args...>
+  constexpr explicit aligned_byte_span(Args&&... args) noexcept
+      : base(std::forward<Args>(args)...) {
+    if (!std::is_constant_evaluated()) {
+      assert(is_aligned<Align>(static_cast<const void*>(base::data())));
+    }
+  }
+
+  // From a span with at least the same alignment
+  template <typename OtherB, size_t OtherExtent, size_t OtherAlign>
+    requires(OtherAlign >= Align)
+         && std::constructible_from<base, const byte_span<OtherB, OtherExtent>&>
+  constexpr explicit(Extent != dynamic_extent && OtherExtent == dynamic_extent)
+      // NOLINTNEXTLINE(google-explicit-constructor)
+      aligned_byte_span(
+          const aligned_byte_span<OtherB, OtherExtent, OtherAlign>& other)
+      noexcept
+      : base(static_cast<const byte_span<OtherB, OtherExtent>&>(other)) {}
+
+  [[nodiscard]]
+  constexpr auto data() const noexcept -> pointer {
+    return std::assume_aligned<Align>(base::data());
+  }
+
+  template <size_t Count>
+  [[nodiscard]]
+  constexpr auto first() const noexcept {
+    return adopt<Count, Align>(base::template first<Count>());
+  }
+
+  [[nodiscard]]
+  constexpr auto first(size_type count) const noexcept {
+    return adopt<dynamic_extent, Align>(base::first(count));
+  }
+
+  // Aligned only when the extent is static, so the offset is known.
+  template <size_t Count>
+  [[nodiscard]]
+  constexpr auto last() const noexcept {
+    if constexpr (Extent == dynamic_extent) {
+      return base::template last<Count>();
+    } else {
+      return adopt<Count, detail::offset_alignment(Align, Extent - Count)>(
+          base::template last<Count>());
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto last(size_type count) const noexcept {
+    return base::last(count);
+  }
+
+  template <size_t Offset, size_t Count = dynamic_extent>
+  [[nodiscard]]
+  constexpr auto subspan() const noexcept {
+    auto s = base::template subspan<Offset, Count>();
+    return adopt<decltype(s)::extent, detail::offset_alignment(Align, Offset)>(
+        s);
+  }
+
+  [[nodiscard]]
+  constexpr auto subspan(size_type offset,
+                         size_type count = dynamic_extent) const noexcept {
+    return base::subspan(offset, count);
+  }
+
+ private:
+  struct trusted {};
+
+  constexpr aligned_byte_span(trusted /*tag*/, base bytes) noexcept
+      : base(bytes) {}
+
+  // Wraps a part of this span whose alignment follows from its position.
+  template <size_t N, size_t A>
+  static constexpr auto adopt(byte_span<element_type, N> bytes) noexcept {
+    return aligned_byte_span<element_type, N, A>{
+        typename aligned_byte_span<element_type, N, A>::trusted{}, bytes};
+  }
+};
+
+template <size_t Align>
+using aligned_byte_view = aligned_byte_span<std::byte, dynamic_extent, Align>;
+
+template <size_t Align>
+using aligned_cbyte_view =
+    aligned_byte_span<const std::byte, dynamic_extent, Align>;
+
+}  // namespace range3
+
+template <typename B, std::size_t N, std::size_t A>
+constexpr bool
+    std::ranges::enable_borrowed_range<range3::aligned_byte_span<B, N, A>> =
+        true;
+
+template <typename B, std::size_t N, std::size_t A>
+constexpr bool std::ranges::enable_view<range3::aligned_byte_span<B, N, A>> =
+    true;
@@ -0,0 +1,825 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "byte_span/byte_span.hpp"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "byte_span/async_io.hpp requires POSIX pread/pwrite"
+#endif
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// The io_uring backend talks to the kernel through raw system calls, so only
+// the kernel headers are needed, not liburing.
+#if defined(__linux__) && !defined(RANGE3_BYTE_SPAN_NO_IO_URING) \
+    && __has_include(<linux/io_uring.h>)
+#define RANGE3_BYTE_SPAN_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace range3 {
+
+enum class io_backend : unsigned char {
+  automatic,    // io_uring when the kernel allows it, else thread_pool
+  io_uring,
+  thread_pool,  // pread/pwrite on worker threads
+};
+
+struct io_queue_options {
+  // Submission queue depth of the io_uring backend
+  unsigned entries = 256;
+  // Worker threads of the thread_pool backend
+  unsigned threads = 4;
+  io_backend backend = io_backend::automatic;
+};
+
+// Outcome of one operation. Like pread and pwrite, a transfer may be shorter
+// than requested; `size` reports what was moved.
+struct io_completion {
+  size_t size{};
+  std::error_code ec;
+
+  explicit operator bool() const noexcept { return !ec; }
+};
+
+using io_callback = std::function<void(io_completion)>;
+
+class io_queue;
+
+namespace detail {
+
+enum class io_opcode : unsigned char { read, write };
+
+struct io_request {
+  io_opcode op;
+  int fd;
+  std::byte* data;
+  size_t size;
+  std::uint64_t offset;
+  int buffer = -1;  // registered buffer index, or -1
+};
+
+struct io_operation {
+  io_request request{};
+  io_callback callback;
+  ::iovec iov{};  // READV/WRITEV argument; lives until completion
+  io_completion result;
+};
+
+inline auto transfer(const io_request& r) noexcept -> io_completion {
+  for (;;) {
+    auto const offset = static_cast<::off_t>(r.offset);
+    auto const n = r.op == io_opcode::read
+                       ? ::pread(r.fd, r.data, r.size, offset)
+                       : ::pwrite(r.fd, r.data, r.size, offset);
+    if (n >= 0) {
+      return {static_cast<size_t>(n), {}};
+    }
+    if (errno != EINTR) {
+      return {0, {errno, std::system_category()}};
+    }
+  }
+}
+
+// Runs transfers on worker threads. Finished operations are collected and
+// handed back to the queue's thread, so callbacks never run on a worker.
+class io_thread_pool {
+ public:
+  explicit io_thread_pool(unsigned threads) {
+    threads = std::max(threads, 1U);
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] { run(); });
+    }
+  }
+
+  io_thread_pool(const io_thread_pool&) = delete;
+  auto operator=(const io_thread_pool&) -> io_thread_pool& = delete;
+
+  ~io_thread_pool() {
+    {
+      std::lock_guard const lock{mutex_};
+      stop_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void post(std::span<io_operation* const> ops) {
+    {
+      std::lock_guard const lock{mutex_};
+      work_.insert(work_.end(), ops.begin(), ops.end());
+    }
+    if (ops.size() == 1) {
+      work_ready_.notify_one();
+    } else {
+      work_ready_.notify_all();
+    }
+  }
+
+  // Appends finished operations to `out`. With `block`, waits for at least
+  // one, so the caller must have some in flight.
+  void take_finished(std::vector<io_operation*>& out, bool block) {
+    std::unique_lock lock{mutex_};
+    if (block) {
+      done_ready_.wait(lock, [this] { return !done_.empty(); });
+    }
+    out.insert(out.end(), done_.begin(), done_.end());
+    done_.clear();
+  }
+
+ private:
+  void run() {
+    std::unique_lock lock{mutex_};
+    for (;;) {
+      work_ready_.wait(lock, [this] { return stop_ || !work_.empty(); });
+      if (work_.empty()) {
+        return;
+      }
+      auto* op = work_.front();
+      work_.pop_front();
+      lock.unlock();
+      op->result = transfer(op->request);
+      lock.lock();
+      done_.push_back(op);
+      done_ready_.notify_one();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable work_ready_;
+  std::condition_variable done_ready_;
+  std::deque<io_operation*> work_;
+  std::vector<io_operation*> done_;
+  bool stop_ = false;
+  std::vector<std::thread> workers_;
+};
+
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+// NOLINTBEGIN(cppcoreguidelines-pro-type-vararg)
+
+// The submission and completion rings shared with the kernel. Entries are
+// published with release stores to the tails and consumed with acquire
+// loads, as in liburing.
+class io_uring_ring {
+ public:
+  io_uring_ring() noexcept = default;
+  io_uring_ring(const io_uring_ring&) = delete;
+  auto operator=(const io_uring_ring&) -> io_uring_ring& = delete;
+  ~io_uring_ring() { close(); }
+
+  auto open(unsigned entries, std::error_code& ec) noexcept -> bool {
+    ec.clear();
+    ::io_uring_params p{};
+    auto const fd = ::syscall(__NR_io_uring_setup, entries, &p);
+    if (fd < 0) {
+      ec.assign(errno, std::system_category());
+      return false;
+    }
+    fd_ = static_cast<int>(fd);
+    sq_size_ = p.sq_off.array + (p.sq_entries * sizeof(unsigned));
+    cq_size_ = p.cq_off.cqes + (p.cq_entries * sizeof(::io_uring_cqe));
+    single_mmap_ = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap_) {
+      sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    }
+    sqes_size_ = p.sq_entries * sizeof(::io_uring_sqe);
+    sq_ = map(sq_size_, IORING_OFF_SQ_RING);
+    cq_ = single_mmap_ || sq_ == nullptr ? sq_
+                                         : map(cq_size_, IORING_OFF_CQ_RING);
+    auto* sqes = cq_ == nullptr ? nullptr : map(sqes_size_, IORING_OFF_SQES);
+    if (sqes == nullptr) {
+      ec.assign(errno, std::system_category());
+      close();
+      return false;
+    }
+    sqes_ = reinterpret_cast<::io_uring_sqe*>(sqes);
+
+    sq_head_ = field(sq_, p.sq_off.head);
+    sq_tail_ = field(sq_, p.sq_off.tail);
+    sq_mask_ = *field(sq_, p.sq_off.ring_mask);
+    sq_entries_ = p.sq_entries;
+    auto* array = field(sq_, p.sq_off.array);
+    for (unsigned i = 0; i < sq_entries_; ++i) {
+      array[i] = i;  // slot i always holds sqes_[i]
+    }
+    cq_head_ = field(cq_, p.cq_off.head);
+    cq_tail_ = field(cq_, p.cq_off.tail);
+    cq_mask_ = *field(cq_, p.cq_off.ring_mask);
+    cq_entries_ = p.cq_entries;
+    cqes_ = reinterpret_cast<::io_uring_cqe*>(
+        static_cast<std::byte*>(cq_) + p.cq_off.cqes);
+    return true;
+  }
+
+  // Operations that may be in flight before the completion ring overflows
+  [[nodiscard]]
+  auto capacity() const noexcept -> unsigned {
+    return cq_entries_;
+  }
+
+  [[nodiscard]]
+  auto unsubmitted() const noexcept -> unsigned {
+    return unsubmitted_;
+  }
+
+  // Fills the next submission entry; false when the submission ring is full.
+  auto push(io_operation* op) noexcept -> bool {
+    auto const tail = *sq_tail_;
+    if (tail - std::atomic_ref{*sq_head_}.load(std::memory_order_acquire)
+        == sq_entries_)
+    {
+      return false;
+    }
+    auto& sqe = sqes_[tail & sq_mask_];
+    std::memset(&sqe, 0, sizeof sqe);
+    auto const& r = op->request;
+    auto const reading = r.op == io_opcode::read;
+    sqe.fd = r.fd;
+    sqe.off = r.offset;
+    sqe.user_data = reinterpret_cast<std::uintptr_t>(op);
+    if (r.buffer >= 0) {
+      sqe.opcode = static_cast<std::uint8_t>(
+          reading ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED);
+      sqe.addr = reinterpret_cast<std::uintptr_t>(r.data);
+      sqe.len = static_cast<std::uint32_t>(
+          std::min<size_t>(r.size, std::numeric_limits<std::int32_t>::max()));
+      sqe.buf_index = static_cast<std::uint16_t>(r.buffer);
+    } else {
+      // READV/WRITEV rather than READ/WRITE keeps kernels from 5.1 working.
+      op->iov = {r.data, r.size};
+      sqe.opcode = static_cast<std::uint8_t>(reading ? IORING_OP_READV
+                                                     : IORING_OP_WRITEV);
+      sqe.addr = reinterpret_cast<std::uintptr_t>(&op->iov);
+      sqe.len = 1;
+    }
+    std::atomic_ref{*sq_tail_}.store(tail + 1, std::memory_order_release);
+    ++unsubmitted_;
+    return true;
+  }
+
+  // Submits the filled entries in one system call and, when `min_complete`
+  // is not zero, waits until that many completions are ready.
+  void enter(unsigned min_complete, std::error_code& ec) noexcept {
+    ec.clear();
+    if (unsubmitted_ == 0 && min_complete == 0) {
+      return;
+    }
+    auto const flags = min_complete != 0 ? IORING_ENTER_GETEVENTS : 0U;
+    for (;;) {
+      auto const n = ::syscall(__NR_io_uring_enter,
+                               fd_,
+                               unsubmitted_,
+                               min_complete,
+                               flags,
+                               nullptr,
+                               0);
+      if (n >= 0) {
+        unsubmitted_ -= static_cast<unsigned>(n);
+        return;
+      }
+      if (errno != EINTR) {
+        ec.assign(errno, std::system_category());
+        return;
+      }
+    }
+  }
+
+  [[nodiscard]]
+  auto ready() const noexcept -> bool {
+    return *cq_head_
+           != std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire);
+  }
+
+  // Takes the oldest completion, if any.
+  auto pop(io_operation*& op, int& res) noexcept -> bool {
+    auto const head = *cq_head_;
+    if (head == std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire)) {
+      return false;
+    }
+    auto const& cqe = cqes_[head & cq_mask_];
+    op = reinterpret_cast<io_operation*>(cqe.user_data);
+    res = cqe.res;
+    std::atomic_ref{*cq_head_}.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pins the pages of `buffers` once, so fixed operations skip the
+  // per-request page lookup.
+  void register_buffers(std::span<const ::iovec> buffers,
+                        std::error_code& ec) noexcept {
+    ec.clear();
+    if (::syscall(__NR_io_uring_register,
+                  fd_,
+                  IORING_REGISTER_BUFFERS,
+                  buffers.data(),
+                  static_cast<unsigned>(buffers.size()))
+        != 0)
+    {
+      ec.assign(errno, std::system_category());
+    }
+  }
+
+  void unregister_buffers() noexcept {
+    ::syscall(
+        __NR_io_uring_register, fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+  }
+
+ private:
+  auto map(size_t size, std::uint64_t offset) const noexcept -> void* {
+    auto* p = ::mmap(nullptr,
+                     size,
+                     PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE,
+                     fd_,
+                     static_cast<::off_t>(offset));
+    return p == MAP_FAILED ? nullptr : p;
+  }
+
+  static auto field(void* ring, std::uint32_t offset) noexcept -> unsigned* {
+    return reinterpret_cast<unsigned*>(static_cast<std::byte*>(ring) + offset);
+  }
+
+  void close() noexcept {
+    if (sqes_ != nullptr) {
+      ::munmap(sqes_, sqes_size_);
+    }
+    if (cq_ != nullptr && cq_ != sq_) {
+      ::munmap(cq_, cq_size_);
+    }
+    if (sq_ != nullptr) {
+      ::munmap(sq_, sq_size_);
+    }
+    if (fd_ != -1) {
+      ::close(fd_);
+    }
+    fd_ = -1;
+    sq_ = cq_ = nullptr;
+    sqes_ = nullptr;
+  }
+
+  int fd_ = -1;
+  bool single_mmap_ = false;
+  void* sq_ = nullptr;
+  void* cq_ = nullptr;
+  size_t sq_size_ = 0;
+  size_t cq_size_ = 0;
+  size_t sqes_size_ = 0;
+  ::io_uring_sqe* sqes_ = nullptr;
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  unsigned cq_entries_ = 0;
+  ::io_uring_cqe* cqes_ = nullptr;
+  unsigned unsubmitted_ = 0;
+};
+
+// NOLINTEND(cppcoreguidelines-pro-type-vararg)
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+#endif
+
+}  // namespace detail
+
+// `co_await` on an io_queue operation. The coroutine is resumed from inside
+// io_queue::wait() or poll() with the operation's io_completion.
+class io_awaitable {
+ public:
+  io_awaitable(io_queue& queue, const detail::io_request& request) noexcept
+      : queue_{&queue}, request_{request} {}
+
+  [[nodiscard]]
+  auto await_ready() const noexcept -> bool {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle);
+
+  auto await_resume() noexcept -> io_completion { return std::move(result_); }
+
+ private:
+  io_queue* queue_;
+  detail::io_request request_;
+  io_completion result_;
+};
+
+// Asynchronous reads and writes at file offsets, targeting caller-owned
+// byte views that must stay valid until the operation completes.
+//
+// Operations are queued by read()/write() and handed to the backend in one
+// batch by submit(); wait() and poll() run the callbacks of finished
+// operations on the calling thread. The io_uring backend submits a whole
+// batch with a single system call. Where io_uring is missing or forbidden,
+// the thread_pool backend performs the same operations with pread/pwrite,
+// so callers do not need to care which one they got.
+//
+// An io_queue is used from one thread at a time. Failures of the queue
+// itself throw std::system_error; failures of an operation are reported in
+// its io_completion.
+class io_queue {
+ public:
+  explicit io_queue(io_queue_options options = {}) {
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+    if (options.backend != io_backend::thread_pool) {
+      std::error_code ec;
+      if (ring_.open(std::max(options.entries, 1U), ec)) {
+        backend_ = io_backend::io_uring;
+        limit_ = ring_.capacity();
+        return;
+      }
+      if (options.backend == io_backend::io_uring) {
+        throw std::system_error{ec, "io_uring_setup"};
+      }
+    }
+#else
+    if (options.backend == io_backend::io_uring) {
+      throw std::system_error{std::make_error_code(std::errc::not_supported),
+                              "io_uring"};
+    }
+#endif
+    backend_ = io_backend::thread_pool;
+    pool_ = std::make_unique<detail::io_thread_pool>(options.threads);
+  }
+
+  io_queue(const io_queue&) = delete;
+  auto operator=(const io_queue&) -> io_queue& = delete;
+
+  // Waits for outstanding operations, running their callbacks, since the
+  // kernel or a worker may still be writing to their buffers.
+  ~io_queue() {
+    try {
+      drain();
+    } catch (const std::system_error&) {  // NOLINT(bugprone-empty-catch)
+    }
+  }
+
+  // Whether an io_queue can be created with `backend` on this system
+  [[nodiscard]]
+  static auto supported(io_backend backend) noexcept -> bool {
+    if (backend != io_backend::io_uring) {
+      return true;
+    }
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+    static bool const available = [] {
+      detail::io_uring_ring probe;
+      std::error_code ec;
+      return probe.open(1, ec);
+    }();
+    return available;
+#else
+    return false;
+#endif
+  }
+
+  // The backend in use; never io_backend::automatic
+  [[nodiscard]]
+  auto backend() const noexcept -> io_backend {
+    return backend_;
+  }
+
+  // Operations queued or in flight
+  [[nodiscard]]
+  auto pending() const noexcept -> size_t {
+    return outstanding_;
+  }
+
+  void read(int fd,
+            byte_view buffer,
+            std::uint64_t offset,
+            io_callback callback) {
+    start(read_request(fd, buffer, offset), std::move(callback));
+  }
+
+  void write(int fd,
+             cbyte_view bytes,
+             std::uint64_t offset,
+             io_callback callback) {
+    start(write_request(fd, bytes, offset), std::move(callback));
+  }
+
+  // Fixed operations target a view inside registered buffer `index`.
+  void read_fixed(int fd,
+                  byte_view buffer,
+                  unsigned index,
+                  std::uint64_t offset,
+                  io_callback callback) {
+    start(fixed(read_request(fd, buffer, offset), index),
+          std::move(callback));
+  }
+
+  void write_fixed(int fd,
+                   cbyte_view bytes,
+                   unsigned index,
+                   std::uint64_t offset,
+                   io_callback callback) {
+    start(fixed(write_request(fd, bytes, offset), index),
+          std::move(callback));
+  }
+
+  [[nodiscard]]
+  auto async_read(int fd, byte_view buffer, std::uint64_t offset) noexcept
+      -> io_awaitable {
+    return {*this, read_request(fd, buffer, offset)};
+  }
+
+  [[nodiscard]]
+  auto async_write(int fd, cbyte_view bytes, std::uint64_t offset) noexcept
+      -> io_awaitable {
+    return {*this, write_request(fd, bytes, offset)};
+  }
+
+  [[nodiscard]]
+  auto async_read_fixed(int fd,
+                        byte_view buffer,
+                        unsigned index,
+                        std::uint64_t offset) noexcept -> io_awaitable {
+    return {*this, fixed(read_request(fd, buffer, offset), index)};
+  }
+
+  [[nodiscard]]
+  auto async_write_fixed(int fd,
+                         cbyte_view bytes,
+                         unsigned index,
+                         std::uint64_t offset) noexcept -> io_awaitable {
+    return {*this, fixed(write_request(fd, bytes, offset), index)};
+  }
+
+  // Registers the buffers used by the fixed operations, replacing any
+  // earlier set. With io_uring the kernel pins their pages once instead of
+  // on every request; the thread pool only records them. No operation may
+  // be pending.
+  void register_buffers(std::span<const byte_view> buffers) {
+    std::error_code ec;
+    register_buffers(buffers, ec);
+    if (ec) {
+      throw std::system_error{ec, "io_queue::register_buffers"};
+    }
+  }
+
+  void register_buffers(std::span<const byte_view> buffers,
+                        std::error_code& ec) noexcept {
+    assert(outstanding_ == 0);
+    ec.clear();
+    unregister_buffers();
+    std::vector<::iovec> vecs;
+    try {
+      vecs.reserve(buffers.size());
+    } catch (const std::bad_alloc&) {
+      ec = std::make_error_code(std::errc::not_enough_memory);
+      return;
+    }
+    for (auto const b : buffers) {
+      vecs.push_back({b.data(), b.size()});
+    }
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+    if (backend_ == io_backend::io_uring) {
+      ring_.register_buffers(vecs, ec);
+      if (ec) {
+        return;
+      }
+    }
+#endif
+    buffers_ = std::move(vecs);
+  }
+
+  void unregister_buffers() noexcept {
+    assert(outstanding_ == 0);
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+    if (backend_ == io_backend::io_uring && !buffers_.empty()) {
+      ring_.unregister_buffers();
+    }
+#endif
+    buffers_.clear();
+  }
+
+  // Hands every queued operation to the backend and returns their count.
+  auto submit() -> size_t {
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+    if (backend_ == io_backend::io_uring) {
+      auto const before = ring_.unsubmitted();
+      std::error_code ec;
+      ring_.enter(0, ec);
+      throw_if(ec, "io_uring_enter");
+      return before - ring_.unsubmitted();
+    }
+#endif
+    auto const count = queued_.size();
+    if (count != 0) {
+      pool_->post(queued_);
+      queued_.clear();
+    }
+    return count;
+  }
+
+  // Runs the callbacks of operations that have already finished, without
+  // blocking. Returns their count.
+  auto poll() -> size_t { return reap(false); }
+
+  // Submits queued operations, then blocks until `count` operations have
+  // completed or none are pending. Operations queued by the callbacks are
+  // submitted and waited for as well. Returns the callbacks run.
+  auto wait(size_t count = 1) -> size_t {
+    size_t done = 0;
+    while (done < count && outstanding_ != 0) {
+      submit();
+      done += reap(true);
+    }
+    return done;
+  }
+
+  // Waits until no operation is pending.
+  void drain() { wait(std::numeric_limits<size_t>::max()); }
+
+ private:
+  friend class io_awaitable;
+
+  static auto read_request(int fd,
+                           byte_view buffer,
+                           std::uint64_t offset) noexcept
+      -> detail::io_request {
+    return {
+        detail::io_opcode::read, fd, buffer.data(), buffer.size(), offset};
+  }
+
+  static auto write_request(int fd,
+                            cbyte_view bytes,
+                            std::uint64_t offset) noexcept
+      -> detail::io_request {
+    // The buffer is only read from; io_request carries one pointer type.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    auto* data = const_cast<std::byte*>(bytes.data());
+    return {detail::io_opcode::write, fd, data, bytes.size(), offset};
+  }
+
+  auto fixed(detail::io_request request, unsigned index) const noexcept
+      -> detail::io_request {
+    assert(index < buffers_.size());
+    [[maybe_unused]] auto const first =
+        reinterpret_cast<std::uintptr_t>(buffers_[index].iov_base);
+    [[maybe_unused]] auto const at =
+        reinterpret_cast<std::uintptr_t>(request.data);
+    assert(at >= first
+           && at + request.size <= first + buffers_[index].iov_len);
+    request.buffer = static_cast<int>(index);
+    return request;
+  }
+
+  static void throw_if(const std::error_code& ec, const char* what) {
+    if (ec) {
+      throw std::system_error{ec, what};
+    }
+  }
+
+  void start(const detail::io_request& request, io_callback callback) {
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+    if (backend_ == io_backend::io_uring) {
+      // Keep completions from outrunning the completion ring.
+      while (outstanding_ >= limit_) {
+        wait(1);
+      }
+      auto* op = acquire(request, std::move(callback));
+      // Only an operation in the ring is counted; one that never got there
+      // would be waited for forever.
+      try {
+        while (!ring_.push(op)) {
+          submit();
+        }
+      } catch (...) {
+        release(op);
+        throw;
+      }
+      ++outstanding_;
+      return;
+    }
+#endif
+    auto* op = acquire(request, std::move(callback));
+    try {
+      queued_.push_back(op);
+    } catch (...) {
+      release(op);
+      throw;
+    }
+    ++outstanding_;
+  }
+
+  auto acquire(const detail::io_request& request, io_callback&& callback)
+      -> detail::io_operation* {
+    detail::io_operation* op = nullptr;
+    if (free_.empty()) {
+      op = &ops_.emplace_back();
+    } else {
+      op = free_.back();
+      free_.pop_back();
+    }
+    op->request = request;
+    op->callback = std::move(callback);
+    return op;
+  }
+
+  void release(detail::io_operation* op) {
+    op->callback = nullptr;
+    free_.push_back(op);
+  }
+
+  // The operation is recycled before its callback runs, so a callback may
+  // start new operations.
+  void complete(detail::io_operation* op, io_completion result) {
+    auto callback = std::move(op->callback);
+    release(op);
+    --outstanding_;
+    if (callback) {
+      callback(std::move(result));
+    }
+  }
+
+  auto reap(bool block) -> size_t {
+    size_t done = 0;
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+    if (backend_ == io_backend::io_uring) {
+      if (block && outstanding_ != 0 && !ring_.ready()) {
+        std::error_code ec;
+        ring_.enter(1, ec);
+        throw_if(ec, "io_uring_enter");
+      }
+      detail::io_operation* op = nullptr;
+      int res = 0;
+      while (ring_.pop(op, res)) {
+        complete(op, to_completion(res));
+        ++done;
+      }
+      return done;
+    }
+#endif
+    if (outstanding_ == queued_.size()) {
+      return 0;  // nothing submitted, so nothing to wait for
+    }
+    std::vector<detail::io_operation*> finished;
+    pool_->take_finished(finished, block);
+    for (auto* op : finished) {
+      complete(op, std::move(op->result));
+      ++done;
+    }
+    return done;
+  }
+
+  static auto to_completion(int res) noexcept -> io_completion {
+    if (res < 0) {
+      return {0, {-res, std::system_category()}};
+    }
+    return {static_cast<size_t>(res), {}};
+  }
+
+  io_backend backend_ = io_backend::thread_pool;
+#if defined(RANGE3_BYTE_SPAN_IO_URING)
+  detail::io_uring_ring ring_;
+  size_t limit_ = 0;
+#endif
+  std::unique_ptr<detail::io_thread_pool> pool_;
+  std::vector<detail::io_operation*> queued_;  // thread_pool only
+  std::deque<detail::io_operation> ops_;       // stable addresses
+  std::vector<detail::io_operation*> free_;
+  std::vector<::iovec> buffers_;
+  size_t outstanding_ = 0;
+};
+
+inline void io_awaitable::await_suspend(std::coroutine_handle<> handle) {
+  queue_->start(request_, [this, handle](io_completion result) {
+    result_ = std::move(result);
+    handle.resume();
+  });
+}
+
+}  // namespace range3
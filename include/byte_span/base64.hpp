@@ -0,0 +1,359 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/simd.hpp"
+#include "byte_span/error.hpp"
+
+namespace range3 {
+
+// RFC 4648 alphabets. Standard output is padded with '='; URL-safe output is
+// unpadded, as in JWT. Either decoder accepts padded and unpadded input.
+enum class base64_alphabet : unsigned char { standard, url };
+
+[[nodiscard]]
+constexpr auto base64_encoded_size(
+    size_t bytes,
+    base64_alphabet alphabet = base64_alphabet::standard) noexcept -> size_t {
+  if (alphabet == base64_alphabet::standard) {
+    return (bytes + 2) / 3 * 4;
+  }
+  return (bytes / 3 * 4) + (bytes % 3 == 0 ? 0 : (bytes % 3) + 1);
+}
+
+// Bytes decoded from well-formed Base64 `chars`, padded or not.
+[[nodiscard]]
+constexpr auto base64_decoded_size(cbyte_view chars) noexcept -> size_t {
+  auto n = chars.size();
+  for (int pad = 0; pad < 2 && n != 0 && chars[n - 1] == std::byte{'='};
+       ++pad) {
+    --n;
+  }
+  return (n / 4 * 3) + (n % 4 == 0 ? 0 : (n % 4) - 1);
+}
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+inline constexpr std::string_view base64_chars_standard =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+inline constexpr std::string_view base64_chars_url =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+constexpr auto base64_chars(base64_alphabet alphabet) noexcept
+    -> std::string_view {
+  return alphabet == base64_alphabet::standard ? base64_chars_standard
+                                               : base64_chars_url;
+}
+
+// Sextet value of each character, or 0xFF
+template <base64_alphabet Alphabet>
+inline constexpr auto base64_values = [] {
+  std::array<std::uint8_t, 256> table{};
+  table.fill(0xFF);
+  auto const chars = base64_chars(Alphabet);
+  for (std::uint8_t i = 0; i < 64; ++i) {
+    table[static_cast<unsigned char>(chars[i])] = i;
+  }
+  return table;
+}();
+
+// Encodes whole 3-byte groups from byte `at` on, then the tail.
+constexpr void base64_encode_scalar(const std::byte* in,
+                                    size_t n,
+                                    std::byte* out,
+                                    base64_alphabet alphabet,
+                                    size_t at) noexcept {
+  auto const chars = base64_chars(alphabet);
+  auto const put = [&](size_t i, std::uint32_t sextet) {
+    out[i] = static_cast<std::byte>(chars[sextet & 0x3FU]);
+  };
+  auto o = at / 3 * 4;
+  for (; n - at >= 3; at += 3, o += 4) {
+    auto const v = (std::to_integer<std::uint32_t>(in[at]) << 16U)
+                 | (std::to_integer<std::uint32_t>(in[at + 1]) << 8U)
+                 | std::to_integer<std::uint32_t>(in[at + 2]);
+    put(o, v >> 18U);
+    put(o + 1, v >> 12U);
+    put(o + 2, v >> 6U);
+    put(o + 3, v);
+  }
+  auto const rest = n - at;
+  if (rest == 0) {
+    return;
+  }
+  auto v = std::to_integer<std::uint32_t>(in[at]) << 16U;
+  if (rest == 2) {
+    v |= std::to_integer<std::uint32_t>(in[at + 1]) << 8U;
+  }
+  put(o, v >> 18U);
+  put(o + 1, v >> 12U);
+  if (rest == 2) {
+    put(o + 2, v >> 6U);
+  }
+  if (alphabet == base64_alphabet::standard) {
+    out[o + 3] = std::byte{'='};
+    if (rest == 1) {
+      out[o + 2] = std::byte{'='};
+    }
+  }
+}
+
+// Decodes the final 2 or 3 significant characters of a quantum. The bits
+// past the last whole byte must be zero.
+template <base64_alphabet Alphabet>
+constexpr auto base64_decode_tail(const std::byte* in,
+                                  size_t count,
+                                  std::byte* out,
+                                  decode_result r) noexcept -> decode_result {
+  auto const& values = base64_values<Alphabet>;
+  std::uint32_t v = 0;
+  for (size_t i = 0; i < count; ++i) {
+    auto const s = values[std::to_integer<size_t>(in[r.offset + i])];
+    if (s > 63) {
+      return {r.size, r.offset + i, byte_errc::invalid_encoding};
+    }
+    v = (v << 6U) | s;
+  }
+  auto const spare = count == 2 ? 4U : 2U;
+  if ((v & ((1U << spare) - 1)) != 0) {
+    return {r.size, r.offset + count - 1, byte_errc::invalid_encoding};
+  }
+  v >>= spare;
+  if (count == 3) {
+    out[r.size++] = static_cast<std::byte>(v >> 8U);
+  }
+  out[r.size++] = static_cast<std::byte>(v);
+  r.offset += count;
+  return r;
+}
+
+// Decodes whole quanta from `r.offset` on, then the padded or unpadded tail.
+template <base64_alphabet Alphabet>
+constexpr auto base64_decode_scalar(const std::byte* in,
+                                    size_t n,
+                                    std::byte* out,
+                                    decode_result r) noexcept
+    -> decode_result {
+  auto const& values = base64_values<Alphabet>;
+  auto const is_pad = [&](size_t i) { return in[i] == std::byte{'='}; };
+  for (; n - r.offset >= 4; r.offset += 4, r.size += 3) {
+    auto const* q = in + r.offset;
+    auto const s0 = values[std::to_integer<size_t>(q[0])];
+    auto const s1 = values[std::to_integer<size_t>(q[1])];
+    auto const s2 = values[std::to_integer<size_t>(q[2])];
+    auto const s3 = values[std::to_integer<size_t>(q[3])];
+    if ((s0 | s1 | s2 | s3) > 63) [[unlikely]] {
+      if (n - r.offset == 4 && is_pad(r.offset + 3)) {
+        auto const count = is_pad(r.offset + 2) ? 2U : 3U;
+        auto t = base64_decode_tail<Alphabet>(in, count, out, r);
+        if (t) {
+          t.offset = n;
+        }
+        return t;
+      }
+      auto at = r.offset;
+      while (values[std::to_integer<size_t>(in[at])] <= 63) {
+        ++at;
+      }
+      return {r.size, at, byte_errc::invalid_encoding};
+    }
+    auto const v = (std::uint32_t{s0} << 18U) | (std::uint32_t{s1} << 12U)
+                 | (std::uint32_t{s2} << 6U) | s3;
+    out[r.size] = static_cast<std::byte>(v >> 16U);
+    out[r.size + 1] = static_cast<std::byte>(v >> 8U);
+    out[r.size + 2] = static_cast<std::byte>(v);
+  }
+  switch (n - r.offset) {
+    case 0:
+      return r;
+    case 1:
+      return {r.size, r.offset, byte_errc::out_of_range};
+    default:
+      return base64_decode_tail<Alphabet>(in, n - r.offset, out, r);
+  }
+}
+
+#if defined(RANGE3_BYTE_SPAN_AVX2)
+
+// 24 input bytes per iteration, after W. Muła and D. Lemire, "Faster Base64
+// Encoding and Decoding Using AVX2 Instructions". Each 128-bit lane expands
+// 12 bytes into 16 sextets with multiplies, which a table lookup then maps
+// to characters. Reads 28 bytes per iteration.
+inline auto base64_encode_avx2(const std::byte* in,
+                               size_t n,
+                               std::byte* out,
+                               base64_alphabet alphabet) noexcept -> size_t {
+  auto const spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10,
+                                       9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6,
+                                       8, 7, 10, 9, 11, 10);
+  // Offset added to a sextet, indexed by its range: 0-25, 26-51, 52-61,
+  // then the two alphabet-specific characters.
+  auto const c62 = static_cast<char>(base64_chars(alphabet)[62] - 62);
+  auto const c63 = static_cast<char>(base64_chars(alphabet)[63] - 63);
+  auto const shift = _mm256_setr_epi8(
+      'A', 'a' - 26, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, c62, c63, 0, 0,
+      'A', 'a' - 26, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, c62, c63, 0, 0);
+  size_t i = 0;
+  for (; n - i >= 28; i += 24) {
+    auto const lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    auto const hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+    auto v = _mm256_shuffle_epi8(
+        _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), spread);
+    auto const t0 = _mm256_mulhi_epu16(
+        _mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)),
+        _mm256_set1_epi32(0x04000040));
+    auto const t1 = _mm256_mullo_epi16(
+        _mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)),
+        _mm256_set1_epi32(0x01000010));
+    v = _mm256_or_si256(t0, t1);
+    auto index = _mm256_subs_epu8(v, _mm256_set1_epi8(51));
+    index = _mm256_sub_epi8(
+        index, _mm256_cmpgt_epi8(v, _mm256_set1_epi8(25)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(out + (i / 3 * 4)),
+        _mm256_add_epi8(v, _mm256_shuffle_epi8(shift, index)));
+  }
+  return i;
+}
+
+// 32 characters per iteration, classified by range compares so that both
+// alphabets share the kernel. Returns the number of characters consumed; a
+// block holding padding or an invalid character is left to the scalar
+// decoder. Each iteration stores 32 bytes for 24 decoded ones, so it only
+// runs while at least 16 more characters follow to overwrite the excess.
+template <base64_alphabet Alphabet>
+inline auto base64_decode_avx2(const std::byte* in,
+                               size_t n,
+                               std::byte* out,
+                               size_t room) noexcept -> size_t {
+  auto const in_range = [](__m256i v, char first, char last) {
+    auto const d = _mm256_sub_epi8(v, _mm256_set1_epi8(first));
+    return _mm256_cmpeq_epi8(
+        _mm256_min_epu8(d, _mm256_set1_epi8(static_cast<char>(last - first))),
+        d);
+  };
+  constexpr auto chars = base64_chars(Alphabet);
+  size_t i = 0;
+  for (; n - i >= 48 && room - (i / 4 * 3) >= 32; i += 32) {
+    auto const v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    auto const upper = in_range(v, 'A', 'Z');
+    auto const lower = in_range(v, 'a', 'z');
+    auto const digit = in_range(v, '0', '9');
+    auto const s62 = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(chars[62]));
+    auto const s63 = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(chars[63]));
+    auto const valid = _mm256_or_si256(
+        _mm256_or_si256(upper, lower),
+        _mm256_or_si256(digit, _mm256_or_si256(s62, s63)));
+    if (_mm256_movemask_epi8(valid) != -1) {
+      break;
+    }
+    auto const pick = [](__m256i mask, int offset) {
+      return _mm256_and_si256(mask,
+                              _mm256_set1_epi8(static_cast<char>(offset)));
+    };
+    auto const offset = _mm256_or_si256(
+        _mm256_or_si256(pick(upper, -'A'), pick(lower, 26 - 'a')),
+        _mm256_or_si256(
+            pick(digit, 52 - '0'),
+            _mm256_or_si256(pick(s62, 62 - chars[62]),
+                            pick(s63, 63 - chars[63]))));
+    auto const sextets = _mm256_add_epi8(v, offset);
+    // (a, b) -> a * 64 + b per 16-bit lane, then (ab, cd) -> ab * 4096 + cd
+    // per 32-bit lane: 24 bits, stored big-endian in each group of four.
+    auto const pairs =
+        _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+    auto const words =
+        _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    auto const packed = _mm256_shuffle_epi8(
+        words,
+        _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                         2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1,
+                         -1));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(out + (i / 4 * 3)),
+        _mm256_permutevar8x32_epi32(
+            packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+  }
+  return i;
+}
+
+#endif
+
+template <base64_alphabet Alphabet>
+constexpr auto base64_decode(cbyte_view chars, byte_view out) noexcept
+    -> decode_result {
+  auto r = decode_result{};
+#if defined(RANGE3_BYTE_SPAN_AVX2)
+  if (!std::is_constant_evaluated()) {
+    r.offset = base64_decode_avx2<Alphabet>(
+        chars.data(), chars.size(), out.data(), out.size());
+    r.size = r.offset / 4 * 3;
+  }
+#endif
+  return base64_decode_scalar<Alphabet>(
+      chars.data(), chars.size(), out.data(), r);
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// Writes the Base64 encoding of `bytes` to the front of `out`, which must hold
+// base64_encoded_size(bytes.size(), alphabet) characters. Returns the count
+// written.
+constexpr auto base64_encode(
+    cbyte_view bytes,
+    byte_view out,
+    base64_alphabet alphabet = base64_alphabet::standard) noexcept -> size_t {
+  assert(out.size() >= base64_encoded_size(bytes.size(), alphabet));
+  size_t done = 0;
+#if defined(RANGE3_BYTE_SPAN_AVX2)
+  if (!std::is_constant_evaluated()) {
+    done = detail::base64_encode_avx2(
+        bytes.data(), bytes.size(), out.data(), alphabet);
+  }
+#endif
+  detail::base64_encode_scalar(
+      bytes.data(), bytes.size(), out.data(), alphabet, done);
+  return base64_encoded_size(bytes.size(), alphabet);
+}
+
+[[nodiscard]]
+inline auto to_base64(cbyte_view bytes,
+                      base64_alphabet alphabet = base64_alphabet::standard)
+    -> std::string {
+  std::string out(base64_encoded_size(bytes.size(), alphabet), '\0');
+  base64_encode(bytes, byte_view{out}, alphabet);
+  return out;
+}
+
+// Decodes Base64 `chars` into the front of `out`, which must hold
+// base64_decoded_size(chars) bytes. A character outside the alphabet,
+// misplaced padding or non-zero trailing bits report
+// byte_errc::invalid_encoding with `offset` at the offending character; a
+// single character left over at the end reports byte_errc::out_of_range.
+// `size` counts the bytes written before the error.
+constexpr auto base64_decode(
+    cbyte_view chars,
+    byte_view out,
+    base64_alphabet alphabet = base64_alphabet::standard) noexcept
+    -> decode_result {
+  assert(out.size() >= base64_decoded_size(chars));
+  if (alphabet == base64_alphabet::standard) {
+    return detail::base64_decode<base64_alphabet::standard>(chars, out);
+  }
+  return detail::base64_decode<base64_alphabet::url>(chars, out);
+}
+
+}  // namespace range3
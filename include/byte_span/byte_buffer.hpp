@@ -0,0 +1,430 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "byte_span/byte_span.hpp"
+
+namespace range3 {
+
+// Tag selecting the constructors and resizes that leave new bytes
+// uninitialized, for buffers that are about to be overwritten anyway.
+struct for_overwrite_t {
+  explicit for_overwrite_t() = default;
+};
+
+inline constexpr for_overwrite_t for_overwrite{};
+
+// An owning, contiguous byte array whose storage is aligned to `Align`
+// bytes. It is a contiguous range of std::byte, so it converts implicitly
+// to byte_view and cbyte_view like std::vector<std::byte> does.
+//
+// Unlike std::vector, growth by resize_for_overwrite() skips zero-filling,
+// and the data is always aligned, e.g. to a cache line or to the block size
+// O_DIRECT requires. std::allocator and std::pmr::polymorphic_allocator
+// allocate with the requested alignment directly; other allocators are
+// asked for Align - 1 extra bytes and the data is aligned within them.
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+template <size_t Align = 64, typename Allocator = std::allocator<std::byte>>
+class basic_byte_buffer {
+  static_assert(std::has_single_bit(Align), "alignment must be a power of 2");
+  static_assert(std::same_as<typename Allocator::value_type, std::byte>,
+                "basic_byte_buffer needs an allocator of std::byte");
+
+  using traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = std::byte;
+  using allocator_type = Allocator;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::byte*;
+  using const_pointer = const std::byte*;
+  using reference = std::byte&;
+  using const_reference = const std::byte&;
+  using iterator = std::byte*;
+  using const_iterator = const std::byte*;
+
+  static constexpr size_t alignment = Align;
+
+  basic_byte_buffer() noexcept(noexcept(Allocator())) = default;
+
+  explicit basic_byte_buffer(const Allocator& alloc) noexcept
+      : alloc_{alloc} {}
+
+  // `size` zero bytes
+  explicit basic_byte_buffer(size_t size, const Allocator& alloc = Allocator())
+      : alloc_{alloc} {
+    resize(size);
+  }
+
+  // `size` uninitialized bytes
+  basic_byte_buffer(size_t size,
+                    for_overwrite_t /*tag*/,
+                    const Allocator& alloc = Allocator())
+      : alloc_{alloc} {
+    resize_for_overwrite(size);
+  }
+
+  explicit basic_byte_buffer(cbyte_view bytes,
+                             const Allocator& alloc = Allocator())
+      : alloc_{alloc} {
+    append(bytes);
+  }
+
+  basic_byte_buffer(const basic_byte_buffer& other)
+      : alloc_{traits::select_on_container_copy_construction(other.alloc_)} {
+    append(other);
+  }
+
+  basic_byte_buffer(const basic_byte_buffer& other, const Allocator& alloc)
+      : alloc_{alloc} {
+    append(other);
+  }
+
+  basic_byte_buffer(basic_byte_buffer&& other) noexcept
+      : alloc_{std::move(other.alloc_)},
+        block_{std::exchange(other.block_, nullptr)},
+        data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)},
+        capacity_{std::exchange(other.capacity_, 0)} {}
+
+  basic_byte_buffer(basic_byte_buffer&& other, const Allocator& alloc)
+      : alloc_{alloc} {
+    if (alloc_ == other.alloc_) {
+      steal(other);
+    } else {
+      append(other);
+    }
+  }
+
+  auto operator=(const basic_byte_buffer& other) -> basic_byte_buffer& {
+    if (this != &other) {
+      if constexpr (traits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_) {
+          release();
+        }
+        alloc_ = other.alloc_;
+      }
+      assign(other);
+    }
+    return *this;
+  }
+
+  auto operator=(basic_byte_buffer&& other) noexcept(
+      traits::propagate_on_container_move_assignment::value
+      || traits::is_always_equal::value) -> basic_byte_buffer& {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (traits::propagate_on_container_move_assignment::value) {
+      release();
+      alloc_ = std::move(other.alloc_);
+      steal(other);
+    } else {
+      if (alloc_ == other.alloc_) {
+        release();
+        steal(other);
+      } else {
+        assign(other);
+      }
+    }
+    return *this;
+  }
+
+  ~basic_byte_buffer() { release(); }
+
+  [[nodiscard]]
+  auto get_allocator() const noexcept -> allocator_type {
+    return alloc_;
+  }
+
+  [[nodiscard]]
+  auto data() noexcept -> std::byte* {
+    return data_;
+  }
+
+  [[nodiscard]]
+  auto data() const noexcept -> const std::byte* {
+    return data_;
+  }
+
+  [[nodiscard]]
+  auto size() const noexcept -> size_t {
+    return size_;
+  }
+
+  [[nodiscard]]
+  auto capacity() const noexcept -> size_t {
+    return capacity_;
+  }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool {
+    return size_ == 0;
+  }
+
+  [[nodiscard]]
+  auto operator[](size_t i) noexcept -> std::byte& {
+    assert(i < size_);
+    return data_[i];
+  }
+
+  [[nodiscard]]
+  auto operator[](size_t i) const noexcept -> const std::byte& {
+    assert(i < size_);
+    return data_[i];
+  }
+
+  [[nodiscard]]
+  auto begin() noexcept -> iterator {
+    return data_;
+  }
+
+  [[nodiscard]]
+  auto begin() const noexcept -> const_iterator {
+    return data_;
+  }
+
+  [[nodiscard]]
+  auto end() noexcept -> iterator {
+    return data_ + size_;
+  }
+
+  [[nodiscard]]
+  auto end() const noexcept -> const_iterator {
+    return data_ + size_;
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) {
+      reallocate(capacity);
+    }
+  }
+
+  // New bytes are zero.
+  void resize(size_t size) { resize(size, std::byte{}); }
+
+  void resize(size_t size, std::byte value) {
+    auto const old = size_;
+    resize_for_overwrite(size);
+    if (size > old) {
+      std::memset(data_ + old, std::to_integer<int>(value), size - old);
+    }
+  }
+
+  // New bytes are left uninitialized.
+  void resize_for_overwrite(size_t size) {
+    if (size > capacity_) {
+      reallocate(grown_capacity(size));
+    }
+    size_ = size;
+  }
+
+  void clear() noexcept { size_ = 0; }
+
+  void shrink_to_fit() {
+    if (size_ == 0) {
+      release();
+    } else if (size_ < capacity_) {
+      reallocate(size_);
+    }
+  }
+
+  void push_back(std::byte value) {
+    resize_for_overwrite(size_ + 1);
+    data_[size_ - 1] = value;
+  }
+
+  void append(cbyte_view bytes) { insert(end(), bytes.begin(), bytes.end()); }
+
+  // Inserts a contiguous range of byte-like values before `pos`. The range
+  // may alias the buffer itself.
+  template <std::contiguous_iterator It, std::sized_sentinel_for<It> End>
+    requires detail::byte_like<std::iter_value_t<It>>
+  auto insert(const_iterator pos, It first, End last) -> iterator {
+    assert(pos >= begin() && pos <= end());
+    auto const at = static_cast<size_t>(pos - begin());
+    auto const count = static_cast<size_t>(last - first);
+    if (count == 0) {
+      return begin() + at;
+    }
+    auto const* src = detail::pointer_cast<const std::byte>(
+        std::to_address(first));
+    if (size_ + count > capacity_ || overlaps(src, count)) {
+      // Copy into new storage while the source is still intact.
+      auto const capacity = grown_capacity(size_ + count);
+      auto const fresh = allocate(capacity);
+      copy(fresh.data, data_, at);
+      copy(fresh.data + at, src, count);
+      copy(fresh.data + at + count, data_ + at, size_ - at);
+      adopt(fresh, capacity, size_);
+    } else {
+      if (at != size_) {
+        std::memmove(data_ + at + count, data_ + at, size_ - at);
+      }
+      std::memcpy(data_ + at, src, count);
+    }
+    size_ += count;
+    return begin() + at;
+  }
+
+  void swap(basic_byte_buffer& other) noexcept {
+    using std::swap;
+    if constexpr (traits::propagate_on_container_swap::value) {
+      swap(alloc_, other.alloc_);
+    } else {
+      assert(alloc_ == other.alloc_);
+    }
+    swap(block_, other.block_);
+    swap(data_, other.data_);
+    swap(size_, other.size_);
+    swap(capacity_, other.capacity_);
+  }
+
+  friend void swap(basic_byte_buffer& a, basic_byte_buffer& b) noexcept {
+    a.swap(b);
+  }
+
+ private:
+  static constexpr bool native_aligned =
+      std::same_as<Allocator, std::allocator<std::byte>>
+      || std::same_as<Allocator, std::pmr::polymorphic_allocator<std::byte>>;
+
+  // Bytes requested from the allocator for `capacity` aligned bytes
+  static constexpr auto block_size(size_t capacity) noexcept -> size_t {
+    return native_aligned ? capacity : capacity + Align - 1;
+  }
+
+  struct allocation {
+    std::byte* block;
+    std::byte* data;
+  };
+
+  auto allocate(size_t capacity) -> allocation {
+    if constexpr (std::same_as<Allocator, std::allocator<std::byte>>) {
+      auto* p = static_cast<std::byte*>(
+          ::operator new(capacity, std::align_val_t{Align}));
+      return {p, p};
+    } else if constexpr (std::same_as<
+                             Allocator,
+                             std::pmr::polymorphic_allocator<std::byte>>)
+    {
+      auto* p = static_cast<std::byte*>(alloc_.allocate_bytes(capacity, Align));
+      return {p, p};
+    } else {
+      auto* block =
+          std::to_address(traits::allocate(alloc_, block_size(capacity)));
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto const address = reinterpret_cast<std::uintptr_t>(block);
+      auto const padding = ((address + Align - 1) & ~(Align - 1)) - address;
+      return {block, block + padding};
+    }
+  }
+
+  void deallocate(std::byte* block, size_t capacity) noexcept {
+    if constexpr (std::same_as<Allocator, std::allocator<std::byte>>) {
+      ::operator delete(block, capacity, std::align_val_t{Align});
+    } else if constexpr (std::same_as<
+                             Allocator,
+                             std::pmr::polymorphic_allocator<std::byte>>)
+    {
+      alloc_.deallocate_bytes(block, capacity, Align);
+    } else {
+      traits::deallocate(alloc_, block, block_size(capacity));
+    }
+  }
+
+  // Geometric growth keeps push_back and append amortized O(1).
+  auto grown_capacity(size_t size) const noexcept -> size_t {
+    return std::max(size, capacity_ + (capacity_ / 2));
+  }
+
+  void reallocate(size_t capacity) {
+    auto const fresh = allocate(capacity);
+    copy(fresh.data, data_, size_);
+    adopt(fresh, capacity, size_);
+  }
+
+  // Frees the current storage and takes over `fresh`.
+  void adopt(allocation fresh, size_t capacity, size_t size) noexcept {
+    release();
+    block_ = fresh.block;
+    data_ = fresh.data;
+    size_ = size;
+    capacity_ = capacity;
+  }
+
+  void release() noexcept {
+    if (block_ != nullptr) {
+      deallocate(block_, capacity_);
+    }
+    block_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+  }
+
+  void steal(basic_byte_buffer& other) noexcept {
+    block_ = std::exchange(other.block_, nullptr);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+  }
+
+  void assign(cbyte_view bytes) {
+    clear();
+    append(bytes);
+  }
+
+  auto overlaps(const std::byte* p, size_t count) const noexcept -> bool {
+    std::less<> const before;
+    return data_ != nullptr && before(p, data_ + size_)
+           && before(data_, p + count);
+  }
+
+  static void copy(std::byte* to, const std::byte* from, size_t count) {
+    if (count != 0) {
+      std::memcpy(to, from, count);
+    }
+  }
+
+  [[no_unique_address]] Allocator alloc_{};
+  std::byte* block_ = nullptr;  // start of the allocation
+  std::byte* data_ = nullptr;   // first aligned byte within it
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+};
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+using byte_buffer = basic_byte_buffer<>;
+
+// Page-aligned storage for O_DIRECT reads and writes, which need buffer
+// addresses aligned to the logical block size of the device.
+using direct_io_buffer = basic_byte_buffer<4096>;
+
+namespace pmr {
+
+template <size_t Align = 64>
+using basic_byte_buffer =
+    range3::basic_byte_buffer<Align,
+                              std::pmr::polymorphic_allocator<std::byte>>;
+
+using byte_buffer = basic_byte_buffer<>;
+
+}  // namespace pmr
+
+}  // namespace range3
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/compare.hpp"
+#include "byte_span/find.hpp"
+
+namespace range3 {
+
+// A logical byte sequence made of non-owning cbyte_view segments, e.g. the
+// fragments of a message that arrived over several reads.
+//
+// append() and consume() are O(1) per segment. Byte offsets are relative to
+// the current front; operator[] and iterator arithmetic locate a segment by
+// binary search. find() and compare() run the vectorized kernels segment by
+// segment and handle matches straddling a boundary without copying.
+// linearize() copies only when the requested prefix spans segments.
+//
+// The viewed memory must outlive the chain. append(), consume() and clear()
+// invalidate iterators and views returned by linearize().
+class byte_chain {
+  struct segment {
+    cbyte_view bytes;
+    size_t start;  // offset of bytes[0] since the chain was created
+  };
+
+ public:
+  using value_type = std::byte;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // Random-access byte iterator that also exposes the contiguous rest of its
+  // segment, so parsers can work a segment at a time.
+  class iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::byte;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::byte*;
+    using reference = const std::byte&;
+
+    iterator() noexcept = default;
+
+    auto operator*() const noexcept -> reference {
+      return chain_->segments_[segment_].bytes[pos_];
+    }
+    auto operator[](difference_type n) const noexcept -> reference {
+      return *(*this + n);
+    }
+    auto operator++() noexcept -> iterator& {
+      if (++pos_ == chain_->segments_[segment_].bytes.size()) {
+        ++segment_;
+        pos_ = 0;
+      }
+      return *this;
+    }
+    auto operator++(int) noexcept -> iterator {
+      auto const old = *this;
+      ++*this;
+      return old;
+    }
+    auto operator--() noexcept -> iterator& {
+      if (pos_ == 0) {
+        --segment_;
+        pos_ = chain_->segments_[segment_].bytes.size();
+      }
+      --pos_;
+      return *this;
+    }
+    auto operator--(int) noexcept -> iterator {
+      auto const old = *this;
+      --*this;
+      return old;
+    }
+    auto operator+=(difference_type n) noexcept -> iterator& {
+      auto const target = static_cast<difference_type>(offset()) + n;
+      return *this = chain_->at(static_cast<size_t>(target));
+    }
+    auto operator-=(difference_type n) noexcept -> iterator& {
+      return *this += -n;
+    }
+    friend auto operator+(iterator it, difference_type n) noexcept
+        -> iterator {
+      return it += n;
+    }
+    friend auto operator+(difference_type n, iterator it) noexcept
+        -> iterator {
+      return it += n;
+    }
+    friend auto operator-(iterator it, difference_type n) noexcept
+        -> iterator {
+      return it -= n;
+    }
+    friend auto operator-(iterator a, iterator b) noexcept -> difference_type {
+      return static_cast<difference_type>(a.offset())
+           - static_cast<difference_type>(b.offset());
+    }
+    friend auto operator==(iterator a, iterator b) noexcept -> bool {
+      return a.segment_ == b.segment_ && a.pos_ == b.pos_;
+    }
+    friend auto operator<=>(iterator a, iterator b) noexcept
+        -> std::strong_ordering {
+      if (auto const c = a.segment_ <=> b.segment_; c != 0) {
+        return c;
+      }
+      return a.pos_ <=> b.pos_;
+    }
+
+    // Offset from the front of the chain
+    [[nodiscard]]
+    auto offset() const noexcept -> size_t {
+      if (segment_ == chain_->segments_.size()) {
+        return chain_->size();
+      }
+      return chain_->segments_[segment_].start + pos_ - chain_->front_;
+    }
+
+    // The bytes from here to the end of the current segment; empty at end().
+    [[nodiscard]]
+    auto segment() const noexcept -> cbyte_view {
+      if (segment_ == chain_->segments_.size()) {
+        return {};
+      }
+      return chain_->segments_[segment_].bytes.subspan(pos_);
+    }
+
+   private:
+    friend class byte_chain;
+
+    iterator(const byte_chain* chain, size_t segment, size_t pos) noexcept
+        : chain_{chain}, segment_{segment}, pos_{pos} {}
+
+    const byte_chain* chain_ = nullptr;
+    size_t segment_ = 0;
+    size_t pos_ = 0;
+  };
+
+  byte_chain() = default;
+
+  byte_chain(std::initializer_list<cbyte_view> segments) {
+    for (auto const s : segments) {
+      append(s);
+    }
+  }
+
+  // Adds a segment at the back. Empty views are ignored.
+  void append(cbyte_view bytes) {
+    if (!bytes.empty()) {
+      segments_.push_back({bytes, back_});
+      back_ += bytes.size();
+    }
+  }
+
+  // Drops `count` bytes from the front.
+  void consume(size_t count) noexcept {
+    assert(count <= size());
+    front_ += count;
+    while (!segments_.empty()) {
+      auto& head = segments_.front();
+      if (head.start + head.bytes.size() > front_) {
+        head.bytes = head.bytes.subspan(front_ - head.start);
+        head.start = front_;
+        return;
+      }
+      segments_.pop_front();
+    }
+  }
+
+  void clear() noexcept {
+    segments_.clear();
+    front_ = back_;
+  }
+
+  // Number of bytes
+  [[nodiscard]]
+  auto size() const noexcept -> size_t {
+    return back_ - front_;
+  }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool {
+    return front_ == back_;
+  }
+
+  [[nodiscard]]
+  auto segment_count() const noexcept -> size_t {
+    return segments_.size();
+  }
+
+  // The segments as a random-access range of cbyte_view
+  [[nodiscard]]
+  auto segments() const noexcept {
+    return segments_ | std::views::transform(&segment::bytes);
+  }
+
+  [[nodiscard]]
+  auto operator[](size_t offset) const noexcept -> std::byte {
+    assert(offset < size());
+    return *at(offset);
+  }
+
+  [[nodiscard]]
+  auto begin() const noexcept -> iterator {
+    return {this, 0, 0};
+  }
+
+  [[nodiscard]]
+  auto end() const noexcept -> iterator {
+    return {this, segments_.size(), 0};
+  }
+
+  // Copies up to out.size() bytes starting at `offset` into `out` and returns
+  // their count.
+  auto copy_to(byte_view out, size_t offset = 0) const noexcept -> size_t {
+    size_t done = 0;
+    for (auto it = at(std::min(offset, size()));
+         done < out.size() && it != end();
+         it = next_segment(it)) {
+      auto const n = std::min(it.segment().size(), out.size() - done);
+      std::ranges::copy(it.segment().first(n), out.subspan(done).begin());
+      done += n;
+    }
+    return done;
+  }
+
+  // The first `count` bytes as one contiguous view. When they lie in the
+  // first segment that segment is returned directly; otherwise they are
+  // copied into scratch storage owned by the chain, valid until the next
+  // linearize() or modification.
+  [[nodiscard]]
+  auto linearize(size_t count) -> cbyte_view {
+    assert(count <= size());
+    if (count == 0) {
+      return {};
+    }
+    auto const head = segments_.front().bytes;
+    if (count <= head.size()) {
+      return head.first(count);
+    }
+    scratch_.resize(count);
+    copy_to(byte_view{scratch_});
+    return cbyte_view{scratch_};
+  }
+
+  // Offset of the first `value` at or after `pos`, or npos.
+  [[nodiscard]]
+  auto find(std::byte value, size_t pos = 0) const noexcept -> size_t {
+    for (auto it = at(std::min(pos, size())); it != end();
+         it = next_segment(it)) {
+      if (auto const r = range3::find(it.segment(), value); r != npos) {
+        return it.offset() + r;
+      }
+    }
+    return npos;
+  }
+
+  // Offset of the first occurrence of `needle` at or after `pos`, or npos.
+  // Matches may straddle any number of segment boundaries.
+  [[nodiscard]]
+  auto find(cbyte_view needle, size_t pos = 0) const noexcept -> size_t {
+    if (pos > size() || needle.size() > size() - pos) {
+      return npos;
+    }
+    if (needle.empty()) {
+      return pos;
+    }
+    for (auto it = at(pos); it != end(); it = next_segment(it)) {
+      auto const here = it.segment();
+      // Matches inside the segment come first...
+      if (auto const r = range3::find(here, needle); r != npos) {
+        return it.offset() + r;
+      }
+      // ...then those starting in its last needle.size() - 1 bytes.
+      auto const first = here.size() >= needle.size()
+                           ? here.size() - needle.size() + 1
+                           : 0;
+      for (auto i = first; i < here.size(); ++i) {
+        if (here[i] == needle[0]
+            && starts_with(needle, it.offset() + i)) {
+          return it.offset() + i;
+        }
+      }
+    }
+    return npos;
+  }
+
+  // Lexicographic comparison of the bytes from `pos` (at most `count` of
+  // them) with `other`, like std::string_view::compare.
+  [[nodiscard]]
+  auto compare(size_t pos, size_t count, cbyte_view other) const noexcept
+      -> std::strong_ordering {
+    assert(pos <= size());
+    auto const length = std::min(count, size() - pos);
+    size_t done = 0;
+    for (auto it = at(pos); done < length && done < other.size();
+         it = next_segment(it)) {
+      auto const n =
+          std::min({it.segment().size(), length - done, other.size() - done});
+      auto const c =
+          range3::compare(it.segment().first(n), other.subspan(done, n));
+      if (c != 0) {
+        return c;
+      }
+      done += n;
+    }
+    return length <=> other.size();
+  }
+
+  [[nodiscard]]
+  auto compare(cbyte_view other) const noexcept -> std::strong_ordering {
+    return compare(0, size(), other);
+  }
+
+  // Whether `prefix` occurs at `pos`
+  [[nodiscard]]
+  auto starts_with(cbyte_view prefix, size_t pos = 0) const noexcept -> bool {
+    return pos <= size() && prefix.size() <= size() - pos
+        && compare(pos, prefix.size(), prefix) == 0;
+  }
+
+  friend auto operator==(const byte_chain& chain, cbyte_view bytes) noexcept
+      -> bool {
+    return chain.size() == bytes.size() && chain.starts_with(bytes);
+  }
+
+ private:
+  // Iterator at `offset` from the front; end() at size().
+  [[nodiscard]]
+  auto at(size_t offset) const noexcept -> iterator {
+    if (offset >= size()) {
+      return end();
+    }
+    auto const target = front_ + offset;
+    auto const& head = segments_.front();
+    if (target < head.start + head.bytes.size()) {
+      return {this, 0, target - head.start};
+    }
+    auto const s = std::ranges::upper_bound(
+                       segments_, target, {}, &segment::start)
+                 - 1;
+    return {this,
+            static_cast<size_t>(s - segments_.begin()),
+            target - s->start};
+  }
+
+  [[nodiscard]]
+  auto next_segment(iterator it) const noexcept -> iterator {
+    return {this, it.segment_ + 1, 0};
+  }
+
+  std::deque<segment> segments_;
+  std::vector<std::byte> scratch_;
+  size_t front_ = 0;  // offset of the first byte since creation
+  size_t back_ = 0;   // offset one past the last byte since creation
+};
+
+}  // namespace range3
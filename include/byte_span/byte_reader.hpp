@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/bit.hpp"
+#include "byte_span/endian.hpp"
+#include "byte_span/error.hpp"
+
+namespace range3 {
+
+namespace detail {
+
+template <typename T>
+concept readable_value = std::is_trivially_copyable_v<T>
+                      && !std::is_array_v<T> && !std::is_const_v<T>;
+
+}  // namespace detail
+
+// Sequential cursor over a cbyte_view with no bounds checks beyond assert.
+// Obtained from byte_reader::reserve once the bytes are known to be present.
+class unchecked_byte_reader {
+ public:
+  constexpr unchecked_byte_reader() noexcept = default;
+  constexpr explicit unchecked_byte_reader(cbyte_view bytes) noexcept
+      : begin_{bytes.data()}, cur_{bytes.data()}, size_{bytes.size()} {}
+
+  [[nodiscard]]
+  constexpr auto position() const noexcept -> size_t {
+    return static_cast<size_t>(cur_ - begin_);
+  }
+
+  [[nodiscard]]
+  constexpr auto remaining() const noexcept -> size_t {
+    return size_ - position();
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool {
+    return remaining() == 0;
+  }
+
+  // The unread bytes
+  [[nodiscard]]
+  constexpr auto rest() const noexcept -> cbyte_view {
+    return cbyte_view{cur_, remaining()};
+  }
+
+  // Trivially copyable value in host representation
+  template <detail::readable_value T>
+  [[nodiscard]]
+  constexpr auto peek() const noexcept -> T {
+    assert(remaining() >= sizeof(T));
+    return detail::load_value<T>(cur_);
+  }
+
+  template <detail::readable_value T>
+  constexpr auto read() noexcept -> T {
+    auto const value = peek<T>();
+    advance(sizeof(T));
+    return value;
+  }
+
+  template <detail::endian_value T>
+  constexpr auto read_le() noexcept -> T {
+    assert(remaining() >= sizeof(T));
+    auto const value = detail::load_endian<T, std::endian::little>(cur_);
+    advance(sizeof(T));
+    return value;
+  }
+
+  template <detail::endian_value T>
+  constexpr auto read_be() noexcept -> T {
+    assert(remaining() >= sizeof(T));
+    auto const value = detail::load_endian<T, std::endian::big>(cur_);
+    advance(sizeof(T));
+    return value;
+  }
+
+  // Sub-view of the next `count` bytes; nothing is copied.
+  constexpr auto read_bytes(size_t count) noexcept -> cbyte_view {
+    assert(remaining() >= count);
+    auto const bytes = cbyte_view{cur_, count};
+    advance(count);
+    return bytes;
+  }
+
+  template <size_t Count>
+  constexpr auto read_bytes() noexcept -> byte_span<const std::byte, Count> {
+    assert(remaining() >= Count);
+    auto const bytes = byte_span<const std::byte, Count>{cur_, Count};
+    advance(Count);
+    return bytes;
+  }
+
+  constexpr void skip(size_t count) noexcept {
+    assert(remaining() >= count);
+    advance(count);
+  }
+
+ private:
+  constexpr void advance(size_t count) noexcept {
+    cur_ += count;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+
+  const std::byte* begin_{};
+  const std::byte* cur_{};
+  size_t size_{};
+};
+
+// Sequential cursor over a cbyte_view. Every operation checks that enough
+// bytes remain and reports shortfalls as byte_errc::out_of_range without
+// consuming anything. Results are std::expected in C++23 and byte_result in
+// C++20. For fixed-size records, reserve() checks once and returns an
+// unchecked_byte_reader over the reserved bytes.
+class byte_reader {
+ public:
+  template <typename T>
+  using result = byte_result<T>;
+
+  constexpr byte_reader() noexcept = default;
+  constexpr explicit byte_reader(cbyte_view bytes) noexcept : cursor_{bytes} {}
+
+  [[nodiscard]]
+  constexpr auto position() const noexcept -> size_t {
+    return cursor_.position();
+  }
+
+  [[nodiscard]]
+  constexpr auto remaining() const noexcept -> size_t {
+    return cursor_.remaining();
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool {
+    return cursor_.empty();
+  }
+
+  [[nodiscard]]
+  constexpr auto rest() const noexcept -> cbyte_view {
+    return cursor_.rest();
+  }
+
+  template <detail::readable_value T>
+  [[nodiscard]]
+  constexpr auto peek() const noexcept -> result<T> {
+    if (remaining() < sizeof(T)) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    return cursor_.peek<T>();
+  }
+
+  template <detail::readable_value T>
+  constexpr auto read() noexcept -> result<T> {
+    if (remaining() < sizeof(T)) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    return cursor_.read<T>();
+  }
+
+  template <detail::endian_value T>
+  constexpr auto read_le() noexcept -> result<T> {
+    if (remaining() < sizeof(T)) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    return cursor_.read_le<T>();
+  }
+
+  template <detail::endian_value T>
+  constexpr auto read_be() noexcept -> result<T> {
+    if (remaining() < sizeof(T)) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    return cursor_.read_be<T>();
+  }
+
+  constexpr auto read_bytes(size_t count) noexcept -> result<cbyte_view> {
+    if (remaining() < count) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    return cursor_.read_bytes(count);
+  }
+
+  template <size_t Count>
+  constexpr auto read_bytes() noexcept
+      -> result<byte_span<const std::byte, Count>> {
+    if (remaining() < Count) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    return cursor_.read_bytes<Count>();
+  }
+
+  constexpr auto skip(size_t count) noexcept -> result<void> {
+    if (remaining() < count) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    cursor_.skip(count);
+    return {};
+  }
+
+  // Consumes `count` bytes and returns a cursor over them whose reads are
+  // not checked again.
+  constexpr auto reserve(size_t count) noexcept
+      -> result<unchecked_byte_reader> {
+    if (remaining() < count) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    return unchecked_byte_reader{cursor_.read_bytes(count)};
+  }
+
+ private:
+  unchecked_byte_reader cursor_;
+};
+
+}  // namespace range3
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
@@ -20,36 +21,36 @@ class byte_span;
 
 namespace detail {
 
+// These traits are checked for every constructor candidate, so they are
+// variable template specializations, the cheapest check there is, rather
+// than requires-expressions compared with std::same_as.
+
+template <typename T>
+inline constexpr bool is_byte_like_v = false;
+template <>
+inline constexpr bool is_byte_like_v<char> = true;
+template <>
+inline constexpr bool is_byte_like_v<unsigned char> = true;
+template <>
+inline constexpr bool is_byte_like_v<std::byte> = true;
+
 template <typename T>
-concept byte_like = std::same_as<std::remove_cv_t<T>, char>
-                 || std::same_as<std::remove_cv_t<T>, unsigned char>
-                 || std::same_as<std::remove_cv_t<T>, std::byte>;
+concept byte_like = is_byte_like_v<std::remove_cv_t<T>>;
 
 template <typename From, typename To>
 concept const_convertible = std::is_const_v<std::remove_reference_t<To>>
                          || !std::is_const_v<std::remove_reference_t<From>>;
 
+// Types with a constructor of their own, which the range constructor skips:
+// C arrays, std::array, std::span and byte_span.
 template <typename T>
-concept is_byte_span = requires {
-  typename T::element_type;
-  { T::extent } -> std::convertible_to<std::size_t>;
-} && std::same_as<T, byte_span<typename T::element_type, T::extent>>;
-
-template <typename T>
-concept is_std_span = requires {
-  typename T::element_type;
-  { T::extent } -> std::convertible_to<std::size_t>;
-} && std::same_as<T, std::span<typename T::element_type, T::extent>>;
-
-template <typename T>
-concept is_std_array =
-    requires {
-      typename T::value_type;
-      std::tuple_size<T>::value;
-    }
-    && std::same_as<
-        T,
-        std::array<typename T::value_type, std::tuple_size<T>::value>>;
+inline constexpr bool has_own_constructor_v = std::is_array_v<T>;
+template <typename T, size_t N>
+inline constexpr bool has_own_constructor_v<std::array<T, N>> = true;
+template <typename T, size_t N>
+inline constexpr bool has_own_constructor_v<std::span<T, N>> = true;
+template <typename B, size_t N>
+inline constexpr bool has_own_constructor_v<byte_span<B, N>> = true;
 
 template <typename T>
 constexpr auto calculate_size(size_t count) noexcept -> size_t {
@@ -66,7 +67,13 @@ using void_pointer_for =
 
 template <typename To, typename From>
 constexpr auto pointer_cast(From* p) noexcept -> To* {
-  return static_cast<To*>(static_cast<void_pointer_for<From>>(p));
+  // No round trip through void* when the types already match, so that
+  // std::byte views stay usable in constant expressions.
+  if constexpr (std::is_convertible_v<From*, To*>) {
+    return p;
+  } else {
+    return static_cast<To*>(static_cast<void_pointer_for<From>>(p));
+  }
 }
 
 }  // namespace detail
@@ -88,7 +95,7 @@ class byte_span {
   using const_reference = typename span_type::const_reference;
   using iterator = typename span_type::iterator;
   using reverse_iterator = typename span_type::reverse_iterator;
-#if __cplusplus > 202002L
+#if defined(__cpp_lib_ranges_as_const)
   using const_iterator = typename span_type::const_iterator;
   using const_reverse_iterator = typename span_type::const_reverse_iterator;
 #endif
@@ -169,10 +176,7 @@ class byte_span {
 
   // From Ranges
   template <typename Range>
-    requires(!detail::is_std_span<std::remove_cvref_t<Range>>)
-         && (!detail::is_byte_span<std::remove_cvref_t<Range>>)
-         && (!detail::is_std_array<std::remove_cvref_t<Range>>)
-         && (!std::is_array_v<std::remove_cvref_t<Range>>)
+    requires(!detail::has_own_constructor_v<std::remove_cvref_t<Range>>)
          && std::ranges::contiguous_range<Range>
          && std::ranges::sized_range<Range>
          && (std::ranges::borrowed_range<Range>
@@ -281,7 +285,7 @@ class byte_span {
     return span_.rend();
   }
 
-#if __cplusplus > 202002L
+#if defined(__cpp_lib_ranges_as_const)
   // C++23
   [[nodiscard]]
   constexpr auto cbegin() const noexcept -> const_iterator {
@@ -313,7 +317,7 @@ class byte_span {
 
   [[nodiscard]]
   constexpr auto first(size_type count) const noexcept {
-    return byte_span{span_.first(count)};
+    return byte_span<element_type>{span_.first(count)};
   }
 
   template <size_t Count>
@@ -325,20 +329,22 @@ class byte_span {
 
   [[nodiscard]]
   constexpr auto last(size_type count) const noexcept {
-    return byte_span{span_.last(count)};
+    return byte_span<element_type>{span_.last(count)};
   }
 
   template <size_t Offset, size_t Count = dynamic_extent>
   [[nodiscard]]
   constexpr auto subspan() const noexcept {
+    // Spelled out: inside the class, plain `byte_span` names this
+    // specialization rather than deducing one.
     auto s = span_.template subspan<Offset, Count>();
-    return byte_span{s};
+    return byte_span<element_type, decltype(s)::extent>{s};
   }
 
   [[nodiscard]]
   constexpr auto subspan(size_type offset,
                          size_type count = dynamic_extent) const noexcept {
-    return byte_span{span_.subspan(offset, count)};
+    return byte_span<element_type>{span_.subspan(offset, count)};
   }
 
   constexpr void swap(byte_span& other) noexcept {
@@ -362,6 +368,8 @@ constexpr auto as_sv(byte_span<B, N> bytes) noexcept -> std::string_view {
   return {detail::pointer_cast<const char>(bytes.data()), bytes.size()};
 }
 
+// View of a T object that already lives at bytes.data(), suitably aligned.
+// For raw wire or file bytes use load<T>() from unaligned.hpp instead.
 template <typename T, typename B, size_t N>
   requires std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>
             && (!std::is_void_v<T>) && (N == dynamic_extent || N >= sizeof(T))
@@ -400,6 +408,7 @@ constexpr auto as_writable_span(byte_span<B, N> bytes) noexcept
 }
 
 // byte_span -> std::span<const T>
+// Same precondition as as_value; unaligned_span<const T> has none.
 template <typename T, typename B, size_t N>
   requires std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>
             && (N == dynamic_extent || (N % sizeof(T) == 0))
@@ -467,8 +476,12 @@ byte_span(std::span<ElementType, Extent>)
                  Extent == dynamic_extent ? dynamic_extent
                                           : Extent * sizeof(ElementType)>;
 
-// From contiguous_range
-template <std::ranges::contiguous_range Range>
+// From contiguous_range. Types with their own guide are ruled out first, so
+// that contiguous_range is not checked for them: for std::span that check
+// instantiates the iterator concepts once per element type and extent.
+template <typename Range>
+  requires(!detail::has_own_constructor_v<std::remove_cvref_t<Range>>)
+       && std::ranges::contiguous_range<Range>
 byte_span(Range&&)
     -> byte_span<std::conditional_t<std::is_const_v<std::remove_reference_t<
                                         std::ranges::range_reference_t<Range>>>,
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/bit.hpp"
+#include "byte_span/endian.hpp"
+#include "byte_span/error.hpp"
+
+namespace range3 {
+
+namespace detail {
+
+template <typename T>
+concept writable_value =
+    std::is_trivially_copyable_v<T> && !std::is_array_v<T>;
+
+// Contiguous containers of byte-like elements that can append a range at the
+// end, e.g. std::vector<std::byte> or std::string.
+template <typename C>
+concept growable_byte_container =
+    std::ranges::contiguous_range<C> && std::ranges::sized_range<C>
+    && byte_like<std::ranges::range_value_t<C>>
+    && !std::is_const_v<
+        std::remove_reference_t<std::ranges::range_reference_t<C>>>
+    && requires(C& c,
+                const std::ranges::range_value_t<C>* p,
+                std::ranges::range_size_t<C> n) {
+         c.insert(c.end(), p, p);
+         c.resize(n);
+       };
+
+}  // namespace detail
+
+// Sequential output cursor over a byte_view with no bounds checks beyond
+// assert. Obtained from byte_writer::reserve or growable_byte_writer::reserve.
+class unchecked_byte_writer {
+ public:
+  constexpr unchecked_byte_writer() noexcept = default;
+  constexpr explicit unchecked_byte_writer(byte_view bytes) noexcept
+      : begin_{bytes.data()}, cur_{bytes.data()}, size_{bytes.size()} {}
+
+  [[nodiscard]]
+  constexpr auto position() const noexcept -> size_t {
+    return static_cast<size_t>(cur_ - begin_);
+  }
+
+  [[nodiscard]]
+  constexpr auto remaining() const noexcept -> size_t {
+    return size_ - position();
+  }
+
+  // The bytes written so far
+  [[nodiscard]]
+  constexpr auto written() const noexcept -> byte_view {
+    return byte_view{begin_, position()};
+  }
+
+  // Trivially copyable value in host representation
+  template <detail::writable_value T>
+  constexpr void write(const T& value) noexcept {
+    assert(remaining() >= sizeof(T));
+    detail::store_value(cur_, value);
+    advance(sizeof(T));
+  }
+
+  template <detail::endian_value T>
+  constexpr void write_le(T value) noexcept {
+    assert(remaining() >= sizeof(T));
+    detail::store_endian<std::endian::little>(cur_, value);
+    advance(sizeof(T));
+  }
+
+  template <detail::endian_value T>
+  constexpr void write_be(T value) noexcept {
+    assert(remaining() >= sizeof(T));
+    detail::store_endian<std::endian::big>(cur_, value);
+    advance(sizeof(T));
+  }
+
+  constexpr void write_bytes(cbyte_view bytes) noexcept {
+    assert(remaining() >= bytes.size());
+    if (std::is_constant_evaluated()) {
+      std::copy(bytes.begin(), bytes.end(), cur_);
+    } else if (!bytes.empty()) {
+      std::memcpy(cur_, bytes.data(), bytes.size());
+    }
+    advance(bytes.size());
+  }
+
+  // Leaves `count` bytes untouched, e.g. for a length field written later.
+  constexpr void skip(size_t count) noexcept {
+    assert(remaining() >= count);
+    advance(count);
+  }
+
+  // Consumes `count` bytes and returns a cursor over them.
+  constexpr auto reserve(size_t count) noexcept -> unchecked_byte_writer {
+    assert(remaining() >= count);
+    auto const claimed = unchecked_byte_writer{byte_view{cur_, count}};
+    advance(count);
+    return claimed;
+  }
+
+ private:
+  constexpr void advance(size_t count) noexcept {
+    cur_ += count;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+
+  std::byte* begin_{};
+  std::byte* cur_{};
+  size_t size_{};
+};
+
+// Sequential output cursor over a fixed byte_view. Writes that do not fit
+// report byte_errc::out_of_range and leave the output untouched. Results are
+// std::expected in C++23 and byte_result in C++20.
+class byte_writer {
+ public:
+  template <typename T>
+  using result = byte_result<T>;
+
+  constexpr byte_writer() noexcept = default;
+  constexpr explicit byte_writer(byte_view bytes) noexcept : cursor_{bytes} {}
+
+  [[nodiscard]]
+  constexpr auto position() const noexcept -> size_t {
+    return cursor_.position();
+  }
+
+  [[nodiscard]]
+  constexpr auto remaining() const noexcept -> size_t {
+    return cursor_.remaining();
+  }
+
+  [[nodiscard]]
+  constexpr auto written() const noexcept -> byte_view {
+    return cursor_.written();
+  }
+
+  template <detail::writable_value T>
+  constexpr auto write(const T& value) noexcept -> result<void> {
+    if (remaining() < sizeof(T)) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    cursor_.write(value);
+    return {};
+  }
+
+  template <detail::endian_value T>
+  constexpr auto write_le(T value) noexcept -> result<void> {
+    if (remaining() < sizeof(T)) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    cursor_.write_le(value);
+    return {};
+  }
+
+  template <detail::endian_value T>
+  constexpr auto write_be(T value) noexcept -> result<void> {
+    if (remaining() < sizeof(T)) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    cursor_.write_be(value);
+    return {};
+  }
+
+  constexpr auto write_bytes(cbyte_view bytes) noexcept -> result<void> {
+    if (remaining() < bytes.size()) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    cursor_.write_bytes(bytes);
+    return {};
+  }
+
+  constexpr auto skip(size_t count) noexcept -> result<void> {
+    if (remaining() < count) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    cursor_.skip(count);
+    return {};
+  }
+
+  // Claims the next `count` bytes and returns a cursor over them whose
+  // writes are not checked again.
+  constexpr auto reserve(size_t count) noexcept
+      -> result<unchecked_byte_writer> {
+    if (remaining() < count) [[unlikely]] {
+      return byte_unexpected{byte_errc::out_of_range};
+    }
+    return cursor_.reserve(count);
+  }
+
+ private:
+  unchecked_byte_writer cursor_;
+};
+
+// Appends to a growable container. Growth is delegated to the container's
+// range insert, which is amortized O(1) per byte for std::vector and
+// std::string and does not value-initialize the appended bytes.
+template <detail::growable_byte_container Container = std::vector<std::byte>>
+class growable_byte_writer {
+  using value_type = std::ranges::range_value_t<Container>;
+
+ public:
+  explicit growable_byte_writer(Container& out) noexcept : out_{&out} {}
+
+  [[nodiscard]]
+  auto position() const noexcept -> size_t {
+    return std::ranges::size(*out_);
+  }
+
+  [[nodiscard]]
+  auto written() const noexcept -> byte_view {
+    return byte_view{*out_};
+  }
+
+  template <detail::writable_value T>
+  void write(const T& value) {
+    std::array<std::byte, sizeof(T)> raw;  // NOLINT(*-member-init)
+    detail::store_value(raw.data(), value);
+    append(raw.data(), raw.size());
+  }
+
+  template <detail::endian_value T>
+  void write_le(T value) {
+    std::array<std::byte, sizeof(T)> raw;  // NOLINT(*-member-init)
+    detail::store_endian<std::endian::little>(raw.data(), value);
+    append(raw.data(), raw.size());
+  }
+
+  template <detail::endian_value T>
+  void write_be(T value) {
+    std::array<std::byte, sizeof(T)> raw;  // NOLINT(*-member-init)
+    detail::store_endian<std::endian::big>(raw.data(), value);
+    append(raw.data(), raw.size());
+  }
+
+  void write_bytes(cbyte_view bytes) { append(bytes.data(), bytes.size()); }
+
+  // Appends `count` bytes and returns an unchecked cursor over them. They
+  // are zero unless the container can resize for overwrite, as byte_buffer
+  // can. The cursor is invalidated by the next write through this writer.
+  auto reserve(size_t count) -> unchecked_byte_writer {
+    auto const at = position();
+    if constexpr (requires { out_->resize_for_overwrite(at); }) {
+      out_->resize_for_overwrite(at + count);
+    } else {
+      out_->resize(at + count);
+    }
+    return unchecked_byte_writer{byte_view{*out_}.subspan(at)};
+  }
+
+ private:
+  void append(const std::byte* p, size_t n) {
+    auto const* first = detail::pointer_cast<const value_type>(p);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    out_->insert(out_->end(), first, first + n);
+  }
+
+  Container* out_;
+};
+
+}  // namespace range3
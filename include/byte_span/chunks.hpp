@@ -0,0 +1,150 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+
+#include "byte_span/byte_span.hpp"
+
+namespace range3 {
+
+// The full N-byte blocks of a byte span as a random-access range of
+// byte_span<B, N>, plus the dynamic tail() that is left over.
+//
+// The block count is computed once up front, so iterating the blocks is a
+// pointer bump with no size checks, and every block has a static extent the
+// compiler can unroll over. Iterators support the full random-access
+// arithmetic, so the blocks split cleanly across threads by index.
+template <typename B, size_t N>
+class chunk_view : public std::ranges::view_interface<chunk_view<B, N>> {
+  static_assert(N != 0 && N != dynamic_extent, "chunk size must be fixed");
+
+ public:
+  using block_type = byte_span<B, N>;
+
+  class iterator {
+   public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = block_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = block_type;
+
+    constexpr iterator() noexcept = default;
+    constexpr explicit iterator(B* p) noexcept : p_{p} {}
+
+    [[nodiscard]]
+    constexpr auto operator*() const noexcept -> block_type {
+      return block_type{p_, N};
+    }
+    [[nodiscard]]
+    constexpr auto operator[](difference_type n) const noexcept -> block_type {
+      return *(*this + n);
+    }
+    constexpr auto operator++() noexcept -> iterator& {
+      return *this += 1;
+    }
+    constexpr auto operator++(int) noexcept -> iterator {
+      auto const old = *this;
+      ++*this;
+      return old;
+    }
+    constexpr auto operator--() noexcept -> iterator& {
+      return *this -= 1;
+    }
+    constexpr auto operator--(int) noexcept -> iterator {
+      auto const old = *this;
+      --*this;
+      return old;
+    }
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    constexpr auto operator+=(difference_type n) noexcept -> iterator& {
+      p_ += n * stride;
+      return *this;
+    }
+    constexpr auto operator-=(difference_type n) noexcept -> iterator& {
+      p_ -= n * stride;
+      return *this;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    friend constexpr auto operator+(iterator it, difference_type n) noexcept
+        -> iterator {
+      return it += n;
+    }
+    friend constexpr auto operator+(difference_type n, iterator it) noexcept
+        -> iterator {
+      return it += n;
+    }
+    friend constexpr auto operator-(iterator it, difference_type n) noexcept
+        -> iterator {
+      return it -= n;
+    }
+    friend constexpr auto operator-(iterator a, iterator b) noexcept
+        -> difference_type {
+      return (a.p_ - b.p_) / stride;
+    }
+    friend constexpr auto operator==(iterator a, iterator b) noexcept
+        -> bool = default;
+    friend constexpr auto operator<=>(iterator a, iterator b) noexcept =
+        default;
+
+   private:
+    static constexpr auto stride = static_cast<difference_type>(N);
+
+    B* p_ = nullptr;
+  };
+
+  constexpr chunk_view() noexcept = default;
+
+  template <size_t Extent>
+  constexpr explicit chunk_view(byte_span<B, Extent> bytes) noexcept
+      : data_{bytes.data()},
+        count_{bytes.size() / N},
+        tail_{bytes.size() % N} {}
+
+  [[nodiscard]]
+  constexpr auto begin() const noexcept -> iterator {
+    return iterator{data_};
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept -> iterator {
+    return begin() + static_cast<std::ptrdiff_t>(count_);
+  }
+
+  // Number of full blocks
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_t {
+    return count_;
+  }
+
+  // The bytes after the last full block, fewer than N
+  [[nodiscard]]
+  constexpr auto tail() const noexcept -> byte_span<B> {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return byte_span<B>{data_ + (count_ * N), tail_};
+  }
+
+ private:
+  B* data_ = nullptr;
+  size_t count_ = 0;
+  size_t tail_ = 0;
+};
+
+// Splits `bytes` into byte_span<B, N> blocks and a tail.
+template <size_t N, typename B, size_t Extent>
+[[nodiscard]]
+constexpr auto chunks(byte_span<B, Extent> bytes) noexcept
+    -> chunk_view<B, N> {
+  return chunk_view<B, N>{bytes};
+}
+
+}  // namespace range3
+
+template <typename B, std::size_t N>
+constexpr bool std::ranges::enable_borrowed_range<range3::chunk_view<B, N>> =
+    true;
+
+template <typename B, std::size_t N>
+constexpr bool std::ranges::enable_view<range3::chunk_view<B, N>> = true;
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/bit.hpp"
+#include "byte_span/detail/simd.hpp"
+
+namespace range3 {
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// Offset of the first differing byte of two n-byte buffers, or n.
+template <typename Arch>
+constexpr auto mismatch_kernel(const std::byte* a,
+                               const std::byte* b,
+                               size_t n) noexcept -> size_t {
+  if constexpr (std::is_void_v<Arch>) {
+    for (size_t i = 0; i < n; ++i) {
+      if (a[i] != b[i]) {
+        return i;
+      }
+    }
+    return n;
+  } else {
+    constexpr auto width = Arch::width;
+    if (n < width) {
+      return mismatch_kernel<typename Arch::narrower>(a, b, n);
+    }
+    size_t i = 0;
+    for (; i + width <= n; i += width) {
+      auto const m =
+          ~Arch::eq(Arch::load(a + i), Arch::load(b + i)) & Arch::all;
+      if (m != 0) {
+        return i + static_cast<size_t>(std::countr_zero(m));
+      }
+    }
+    if (i != n) {
+      i = n - width;
+      auto const m =
+          ~Arch::eq(Arch::load(a + i), Arch::load(b + i)) & Arch::all;
+      if (m != 0) {
+        return i + static_cast<size_t>(std::countr_zero(m));
+      }
+    }
+    return n;
+  }
+}
+
+constexpr auto mismatch_bytes(const std::byte* a,
+                              const std::byte* b,
+                              size_t n) noexcept -> size_t {
+  if (std::is_constant_evaluated()) {
+    return mismatch_kernel<void>(a, b, n);
+  }
+  if (a == b) {
+    return n;
+  }
+  return mismatch_kernel<simd::native>(a, b, n);
+}
+
+// Up to eight bytes starting at p as a big-endian integer, so that integer
+// order matches lexicographic byte order.
+template <size_t Size>
+constexpr auto load_be_word(const std::byte* p) noexcept -> std::uint64_t {
+  static_assert(Size > 0 && Size <= 8);
+  std::uint64_t w = 0;
+  if (std::is_constant_evaluated()) {
+    for (size_t i = 0; i < Size; ++i) {
+      w = (w << 8U) | std::to_integer<std::uint64_t>(p[i]);
+    }
+    return w;
+  }
+  std::memcpy(&w, p, Size);
+  if constexpr (std::endian::native == std::endian::little) {
+    w = detail::byteswap(w);
+  }
+  if constexpr (Size < 8) {
+    w >>= (8 - Size) * 8;
+  }
+  return w;
+}
+
+template <size_t Size>
+constexpr auto load_native_word(const std::byte* p) noexcept -> std::uint64_t {
+  if (std::is_constant_evaluated()) {
+    return load_be_word<Size>(p);
+  }
+  std::uint64_t w = 0;
+  std::memcpy(&w, p, Size);
+  return w;
+}
+
+// Static extents up to this size are compared with fully unrolled word code.
+inline constexpr size_t max_unrolled_compare = 64;
+
+template <size_t N>
+constexpr auto static_equal(const std::byte* a, const std::byte* b) noexcept
+    -> bool {
+  std::uint64_t diff = 0;
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    ((diff |= load_native_word<8>(a + I * 8) ^ load_native_word<8>(b + I * 8)),
+     ...);
+  }(std::make_index_sequence<N / 8>{});
+  if constexpr (N % 8 != 0) {
+    diff |= load_native_word<N % 8>(a + N / 8 * 8)
+          ^ load_native_word<N % 8>(b + N / 8 * 8);
+  }
+  return diff == 0;
+}
+
+template <size_t N>
+constexpr auto static_compare(const std::byte* a, const std::byte* b) noexcept
+    -> std::strong_ordering {
+  auto result = std::strong_ordering::equal;
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (void)((result = load_be_word<8>(a + I * 8) <=> load_be_word<8>(b + I * 8),
+            result == 0)
+           && ...);
+  }(std::make_index_sequence<N / 8>{});
+  if constexpr (N % 8 != 0) {
+    if (result == 0) {
+      result = load_be_word<N % 8>(a + N / 8 * 8)
+           <=> load_be_word<N % 8>(b + N / 8 * 8);
+    }
+  }
+  return result;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// Offset of the first differing byte, or the size of the shorter span when
+// one is a prefix of the other.
+[[nodiscard]]
+constexpr auto mismatch(cbyte_view lhs, cbyte_view rhs) noexcept -> size_t {
+  return detail::mismatch_bytes(
+      lhs.data(), rhs.data(), std::min(lhs.size(), rhs.size()));
+}
+
+[[nodiscard]]
+constexpr auto equal(cbyte_view lhs, cbyte_view rhs) noexcept -> bool {
+  return lhs.size() == rhs.size()
+      && detail::mismatch_bytes(lhs.data(), rhs.data(), lhs.size())
+             == lhs.size();
+}
+
+// Lexicographic comparison of unsigned byte values, like memcmp.
+[[nodiscard]]
+constexpr auto compare(cbyte_view lhs, cbyte_view rhs) noexcept
+    -> std::strong_ordering {
+  auto const n = std::min(lhs.size(), rhs.size());
+  auto const m = detail::mismatch_bytes(lhs.data(), rhs.data(), n);
+  if (m != n) {
+    return lhs[m] <=> rhs[m];
+  }
+  return lhs.size() <=> rhs.size();
+}
+
+template <typename B1, size_t N1, typename B2, size_t N2>
+[[nodiscard]]
+constexpr auto operator==(byte_span<B1, N1> lhs,
+                          byte_span<B2, N2> rhs) noexcept -> bool {
+  if constexpr (N1 != dynamic_extent && N2 != dynamic_extent) {
+    if constexpr (N1 != N2) {
+      return false;
+    } else if constexpr (N1 == 0) {
+      return true;
+    } else if constexpr (N1 <= detail::max_unrolled_compare) {
+      return detail::static_equal<N1>(lhs.data(), rhs.data());
+    } else {
+      return equal(lhs, rhs);
+    }
+  } else {
+    return equal(lhs, rhs);
+  }
+}
+
+template <typename B1, size_t N1, typename B2, size_t N2>
+[[nodiscard]]
+constexpr auto operator<=>(byte_span<B1, N1> lhs,
+                           byte_span<B2, N2> rhs) noexcept
+    -> std::strong_ordering {
+  if constexpr (N1 == N2 && N1 != dynamic_extent && N1 != 0
+                && N1 <= detail::max_unrolled_compare) {
+    return detail::static_compare<N1>(lhs.data(), rhs.data());
+  } else {
+    return compare(lhs, rhs);
+  }
+}
+
+}  // namespace range3
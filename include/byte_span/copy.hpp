@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/simd.hpp"
+
+namespace range3 {
+
+// Copies and fills of at least this many bytes bypass the caches by default.
+// Below a few MiB the destination is likely to be read again soon, and the
+// ordinary cached stores of memcpy/memset are faster.
+inline constexpr size_t default_streaming_threshold = size_t{4} << 20U;
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// Bytes before `p` reaches a multiple of `alignment`, at most `n`.
+inline auto head_to_alignment(const std::byte* p,
+                              size_t alignment,
+                              size_t n) noexcept -> size_t {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto const address = reinterpret_cast<std::uintptr_t>(p);
+  return std::min(static_cast<size_t>(-address & (alignment - 1)), n);
+}
+
+// Non-temporal kernels: the unaligned head and the tail use ordinary stores,
+// whole registers in between are streamed to aligned destinations.
+template <typename Arch>
+void stream_copy(const std::byte* in, std::byte* out, size_t n) noexcept {
+  if constexpr (std::is_void_v<Arch>) {
+    std::memcpy(out, in, n);
+  } else {
+    constexpr auto width = Arch::width;
+    auto const head = head_to_alignment(out, width, n);
+    std::memcpy(out, in, head);
+    size_t i = head;
+    for (; i + width <= n; i += width) {
+      Arch::stream(out + i, Arch::load(in + i));
+    }
+    simd::fence();
+    std::memcpy(out + i, in + i, n - i);
+  }
+}
+
+template <typename Arch>
+void stream_fill(std::byte* out, size_t n, std::byte value) noexcept {
+  if constexpr (std::is_void_v<Arch>) {
+    std::memset(out, std::to_integer<int>(value), n);
+  } else {
+    constexpr auto width = Arch::width;
+    auto const head = head_to_alignment(out, width, n);
+    std::memset(out, std::to_integer<int>(value), head);
+    auto const v = Arch::splat(value);
+    size_t i = head;
+    for (; i + width <= n; i += width) {
+      Arch::stream(out + i, v);
+    }
+    simd::fence();
+    std::memset(out + i, std::to_integer<int>(value), n - i);
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// Copies the first min(src.size(), dst.size()) bytes of `src` to `dst` and
+// returns their count. The views must not overlap. Copies of at least
+// `streaming_threshold` bytes use non-temporal stores, so a large copy does
+// not evict the rest of the working set from the caches; the copied data is
+// then not cached either.
+constexpr auto copy(cbyte_view src,
+                    byte_view dst,
+                    size_t streaming_threshold =
+                        default_streaming_threshold) noexcept -> size_t {
+  auto const n = std::min(src.size(), dst.size());
+  if (std::is_constant_evaluated()) {
+    std::copy_n(src.data(), n, dst.data());
+  } else if (n == 0) {
+    // memcpy does not accept the null data() of empty views
+  } else if (n >= streaming_threshold) {
+    detail::stream_copy<detail::simd::native>(src.data(), dst.data(), n);
+  } else {
+    std::memcpy(dst.data(), src.data(), n);
+  }
+  return n;
+}
+
+// Sets every byte of `bytes` to `value`, with non-temporal stores from
+// `streaming_threshold` bytes on.
+constexpr void fill(byte_view bytes,
+                    std::byte value,
+                    size_t streaming_threshold =
+                        default_streaming_threshold) noexcept {
+  if (std::is_constant_evaluated()) {
+    std::fill(bytes.begin(), bytes.end(), value);
+  } else if (bytes.empty()) {
+    // memset does not accept the null data() of an empty view
+  } else if (bytes.size() >= streaming_threshold) {
+    detail::stream_fill<detail::simd::native>(
+        bytes.data(), bytes.size(), value);
+  } else {
+    std::memset(bytes.data(), std::to_integer<int>(value), bytes.size());
+  }
+}
+
+// Zeroes `bytes` even when the compiler can prove they are never read again,
+// e.g. a key in a buffer about to be freed, where a plain memset may be
+// removed as a dead store.
+inline void secure_zero(byte_view bytes) noexcept {
+  if (bytes.empty()) {
+    return;
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  std::memset(bytes.data(), 0, bytes.size());
+  // The compiler must assume the asm reads the zeroed memory.
+  __asm__ __volatile__("" : : "r"(bytes.data()) : "memory");
+#else
+  auto* const p = static_cast<volatile std::byte*>(bytes.data());
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    p[i] = std::byte{0};
+  }
+#endif
+}
+
+}  // namespace range3
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/bit.hpp"
+
+#if !defined(RANGE3_BYTE_SPAN_NO_SIMD) && defined(__SSE4_2__) \
+    && (defined(__x86_64__) || defined(_M_X64))
+#define RANGE3_BYTE_SPAN_CRC32C_SSE42 1
+#if defined(__PCLMUL__)
+#define RANGE3_BYTE_SPAN_CRC32C_PCLMUL 1
+#endif
+#include <immintrin.h>
+#endif
+
+namespace range3 {
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// CRC-32C (Castagnoli), reflected. Polynomials are held bit-reversed: bit 31
+// is the coefficient of x^0.
+inline constexpr std::uint32_t crc32c_poly = 0x82F63B78U;
+
+// a * b mod P
+constexpr auto crc32c_multmodp(std::uint32_t a, std::uint32_t b) noexcept
+    -> std::uint32_t {
+  std::uint32_t m = 1U << 31U;
+  std::uint32_t p = 0;
+  for (;;) {
+    if ((a & m) != 0) {
+      p ^= b;
+      if ((a & (m - 1)) == 0) {
+        break;
+      }
+    }
+    m >>= 1U;
+    b = (b & 1U) != 0 ? (b >> 1U) ^ crc32c_poly : b >> 1U;
+  }
+  return p;
+}
+
+// x^(2^k) mod P for k = 0..31
+inline constexpr auto crc32c_x2n_table = [] {
+  std::array<std::uint32_t, 32> table{};
+  std::uint32_t p = 1U << 30U;  // x^1
+  table[0] = p;
+  for (size_t k = 1; k < table.size(); ++k) {
+    p = crc32c_multmodp(p, p);
+    table[k] = p;
+  }
+  return table;
+}();
+
+// x^(n * 2^k) mod P
+constexpr auto crc32c_x2nmodp(std::uint64_t n, unsigned k) noexcept
+    -> std::uint32_t {
+  std::uint32_t p = 1U << 31U;  // x^0
+  while (n != 0) {
+    if ((n & 1U) != 0) {
+      p = crc32c_multmodp(crc32c_x2n_table[k & 31U], p);
+    }
+    n >>= 1U;
+    ++k;
+  }
+  return p;
+}
+
+// Slicing-by-8 tables for the portable path.
+inline constexpr auto crc32c_table = [] {
+  std::array<std::array<std::uint32_t, 256>, 8> table{};
+  for (std::uint32_t n = 0; n < 256; ++n) {
+    auto c = n;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1U) != 0 ? (c >> 1U) ^ crc32c_poly : c >> 1U;
+    }
+    table[0][n] = c;
+  }
+  for (size_t n = 0; n < 256; ++n) {
+    for (size_t k = 1; k < 8; ++k) {
+      auto const prev = table[k - 1][n];
+      table[k][n] = (prev >> 8U) ^ table[0][prev & 0xFFU];
+    }
+  }
+  return table;
+}();
+
+// The kernels update a raw CRC register; pre- and post-inversion are applied
+// by the public functions.
+constexpr auto crc32c_portable(std::uint32_t crc,
+                               const std::byte* p,
+                               size_t n) noexcept -> std::uint32_t {
+  auto const& t = crc32c_table;
+  for (; n >= 8; n -= 8, p += 8) {
+    auto const lo = read_le<std::uint32_t>(p) ^ crc;
+    auto const hi = read_le<std::uint32_t>(p + 4);
+    crc = t[7][lo & 0xFFU] ^ t[6][(lo >> 8U) & 0xFFU]
+        ^ t[5][(lo >> 16U) & 0xFFU] ^ t[4][lo >> 24U] ^ t[3][hi & 0xFFU]
+        ^ t[2][(hi >> 8U) & 0xFFU] ^ t[1][(hi >> 16U) & 0xFFU]
+        ^ t[0][hi >> 24U];
+  }
+  for (; n != 0; --n, ++p) {
+    auto const b = std::to_integer<std::uint32_t>(*p);
+    crc = (crc >> 8U) ^ t[0][(crc ^ b) & 0xFFU];
+  }
+  return crc;
+}
+
+#if defined(RANGE3_BYTE_SPAN_CRC32C_SSE42)
+
+inline auto crc32c_u64(std::uint32_t crc, const std::byte* p) noexcept
+    -> std::uint32_t {
+  return static_cast<std::uint32_t>(
+      _mm_crc32_u64(crc, read_le<std::uint64_t>(p)));
+}
+
+inline auto crc32c_sse42_serial(std::uint32_t crc,
+                                const std::byte* p,
+                                size_t n) noexcept -> std::uint32_t {
+  for (; n >= 8; n -= 8, p += 8) {
+    crc = crc32c_u64(crc, p);
+  }
+  for (; n != 0; --n, ++p) {
+    crc = _mm_crc32_u8(crc, std::to_integer<unsigned char>(*p));
+  }
+  return crc;
+}
+
+// Shifting a register over Bytes zero bytes, i.e. multiplying by
+// x^(8 * Bytes). With PCLMUL this is one carry-less multiply by
+// x^(8 * Bytes - 33) followed by a crc32 reduction of the 64-bit product.
+template <size_t Bytes>
+inline auto crc32c_shift(std::uint32_t crc) noexcept -> std::uint32_t {
+#if defined(RANGE3_BYTE_SPAN_CRC32C_PCLMUL)
+  static constexpr std::uint32_t k = crc32c_x2nmodp((8 * Bytes) - 33, 0);
+  auto const product = _mm_clmulepi64_si128(
+      _mm_cvtsi32_si128(static_cast<int>(crc)),
+      _mm_cvtsi32_si128(static_cast<int>(k)),
+      0x00);
+  return static_cast<std::uint32_t>(
+      _mm_crc32_u64(0, static_cast<std::uint64_t>(_mm_cvtsi128_si64(product))));
+#else
+  static constexpr std::uint32_t k = crc32c_x2nmodp(Bytes, 3);
+  return crc32c_multmodp(k, crc);
+#endif
+}
+
+// Three independent crc32 chains hide the instruction's 3-cycle latency; the
+// lanes are merged by shifting the earlier ones over the later blocks.
+template <size_t Block>
+inline auto crc32c_sse42_interleaved(std::uint32_t crc,
+                                     const std::byte*& p,
+                                     size_t& n) noexcept -> std::uint32_t {
+  static_assert(Block % 8 == 0);
+  while (n >= 3 * Block) {
+    std::uint32_t c0 = crc;
+    std::uint32_t c1 = 0;
+    std::uint32_t c2 = 0;
+    for (size_t i = 0; i < Block; i += 8) {
+      c0 = crc32c_u64(c0, p + i);
+      c1 = crc32c_u64(c1, p + Block + i);
+      c2 = crc32c_u64(c2, p + (2 * Block) + i);
+    }
+    crc = crc32c_shift<Block>(crc32c_shift<Block>(c0) ^ c1) ^ c2;
+    p += 3 * Block;
+    n -= 3 * Block;
+  }
+  return crc;
+}
+
+inline auto crc32c_sse42(std::uint32_t crc,
+                         const std::byte* p,
+                         size_t n) noexcept -> std::uint32_t {
+  crc = crc32c_sse42_interleaved<8192>(crc, p, n);
+  crc = crc32c_sse42_interleaved<256>(crc, p, n);
+  return crc32c_sse42_serial(crc, p, n);
+}
+
+#endif
+
+constexpr auto crc32c_update(std::uint32_t crc,
+                             const std::byte* p,
+                             size_t n) noexcept -> std::uint32_t {
+#if defined(RANGE3_BYTE_SPAN_CRC32C_SSE42)
+  if (!std::is_constant_evaluated()) {
+    return crc32c_sse42(crc, p, n);
+  }
+#endif
+  return crc32c_portable(crc, p, n);
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// CRC-32C of `bytes`. `crc` is the checksum of the preceding data, so
+// crc32c(b, crc32c(a)) == crc32c(a followed by b).
+[[nodiscard]]
+constexpr auto crc32c(cbyte_view bytes, std::uint32_t crc = 0) noexcept
+    -> std::uint32_t {
+  return ~detail::crc32c_update(~crc, bytes.data(), bytes.size());
+}
+
+// CRC-32C of `a` followed by `b`, given crc1 = crc32c(a), crc2 = crc32c(b) and
+// the length of `b`, without reading either input.
+[[nodiscard]]
+constexpr auto crc32c_combine(std::uint32_t crc1,
+                              std::uint32_t crc2,
+                              std::uint64_t len2) noexcept -> std::uint32_t {
+  return detail::crc32c_multmodp(detail::crc32c_x2nmodp(len2, 3), crc1) ^ crc2;
+}
+
+}  // namespace range3
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <stdlib.h>
+#endif
+
+namespace range3::detail {
+
+// std::byteswap is C++23; this is the C++20 equivalent for unsigned integers.
+template <std::unsigned_integral T>
+constexpr auto byteswap(T value) noexcept -> T {
+#if defined(__cpp_lib_byteswap)
+  return std::byteswap(value);
+#else
+  if constexpr (sizeof(T) == 1) {
+    return value;
+  } else if (!std::is_constant_evaluated()) {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (sizeof(T) == 2) {
+      return __builtin_bswap16(value);
+    } else if constexpr (sizeof(T) == 4) {
+      return __builtin_bswap32(value);
+    } else if constexpr (sizeof(T) == 8) {
+      return __builtin_bswap64(value);
+    }
+#elif defined(_MSC_VER)
+    if constexpr (sizeof(T) == 2) {
+      return _byteswap_ushort(value);
+    } else if constexpr (sizeof(T) == 4) {
+      return _byteswap_ulong(value);
+    } else if constexpr (sizeof(T) == 8) {
+      return _byteswap_uint64(value);
+    }
+#endif
+  }
+  T result = 0;
+  for (unsigned i = 0; i < sizeof(T); ++i) {
+    result = static_cast<T>((result << 8U) | (value & T{0xFF}));
+    value = static_cast<T>(value >> 8U);
+  }
+  return result;
+#endif
+}
+
+// Little-endian unsigned load from possibly unaligned memory.
+template <std::unsigned_integral T>
+constexpr auto read_le(const std::byte* p) noexcept -> T {
+  if (std::is_constant_evaluated()) {
+    T value = 0;
+    for (std::size_t i = sizeof(T); i != 0; --i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      value = static_cast<T>((value << 8U) | std::to_integer<T>(p[i - 1]));
+    }
+    return value;
+  }
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  if constexpr (std::endian::native == std::endian::big) {
+    value = byteswap(value);
+  }
+  return value;
+}
+
+// Little-endian unsigned store to possibly unaligned memory.
+template <std::unsigned_integral T>
+constexpr void write_le(std::byte* p, T value) noexcept {
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      p[i] = static_cast<std::byte>(value >> (8U * i));
+    }
+    return;
+  }
+  if constexpr (std::endian::native == std::endian::big) {
+    value = byteswap(value);
+  }
+  std::memcpy(p, &value, sizeof(T));
+}
+
+// Trivially copyable value in host representation at possibly unaligned
+// memory. Fixed-size memcpy compiles to a plain move.
+template <typename T>
+constexpr auto load_value(const std::byte* p) noexcept -> T {
+  if (std::is_constant_evaluated()) {
+    std::array<std::byte, sizeof(T)> raw{};
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      raw[i] = p[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return std::bit_cast<T>(raw);
+  }
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+template <typename T>
+constexpr void store_value(std::byte* p, const T& value) noexcept {
+  if (std::is_constant_evaluated()) {
+    auto const raw = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+    std::copy(raw.begin(), raw.end(), p);
+    return;
+  }
+  std::memcpy(p, &value, sizeof(T));
+}
+
+}  // namespace range3::detail
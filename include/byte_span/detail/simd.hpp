@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time selection of the widest byte-vector instruction set enabled for
+// the translation unit. Define RANGE3_BYTE_SPAN_NO_SIMD to force the scalar
+// fallbacks everywhere.
+#if !defined(RANGE3_BYTE_SPAN_NO_SIMD)
+#if defined(__AVX512BW__)
+#define RANGE3_BYTE_SPAN_AVX512BW 1
+#endif
+#if defined(__AVX2__)
+#define RANGE3_BYTE_SPAN_AVX2 1
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define RANGE3_BYTE_SPAN_SSSE3 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RANGE3_BYTE_SPAN_SSE2 1
+#endif
+#endif
+
+#if defined(RANGE3_BYTE_SPAN_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace range3::detail::simd {
+
+// Byte shuffle control that reverses every `Size`-byte element of a 128-bit
+// lane, repeated for the widest register.
+template <std::size_t Size>
+inline constexpr auto byteswap_pattern = [] {
+  std::array<std::byte, 64> pattern{};
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    auto const in_lane = i % 16;
+    pattern[i] = static_cast<std::byte>((in_lane / Size * Size) + Size - 1
+                                        - (in_lane % Size));
+  }
+  return pattern;
+}();
+
+// Each architecture tag describes one vector width. `narrower` names the next
+// smaller tag (or void for scalar code) so kernels can hand inputs shorter
+// than one register down the chain instead of peeling byte by byte.
+
+#if defined(RANGE3_BYTE_SPAN_SSE2)
+struct sse2 {
+  using narrower = void;
+  using register_type = __m128i;
+  using mask_type = std::uint32_t;
+  static constexpr std::size_t width = 16;
+  static constexpr mask_type all = 0xFFFFU;
+
+  static auto load(const std::byte* p) noexcept -> register_type {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  static void store(std::byte* p, register_type v) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+  // Non-temporal store that bypasses the caches; `p` must be aligned to
+  // `width`. Needs a fence() before other threads may read the data.
+  static void stream(std::byte* p, register_type v) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm_stream_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+  static auto splat(std::byte b) noexcept -> register_type {
+    return _mm_set1_epi8(static_cast<char>(b));
+  }
+  static auto eq(register_type a, register_type b) noexcept -> mask_type {
+    return static_cast<mask_type>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+  }
+  // Most significant bit of each byte
+  static auto msb(register_type v) noexcept -> mask_type {
+    return static_cast<mask_type>(_mm_movemask_epi8(v));
+  }
+  // Reverses the bytes of every `Size`-byte element. Without SSSE3 the bytes
+  // of each 16-bit word are swapped by shifts and the words reordered.
+  template <std::size_t Size>
+  static auto byteswap(register_type v) noexcept -> register_type {
+#if defined(RANGE3_BYTE_SPAN_SSSE3)
+    return _mm_shuffle_epi8(v, load(byteswap_pattern<Size>.data()));
+#else
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    if constexpr (Size == 4) {
+      v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+    } else if constexpr (Size == 8) {
+      v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+    }
+    return v;
+#endif
+  }
+};
+#endif
+
+#if defined(RANGE3_BYTE_SPAN_AVX2)
+struct avx2 {
+  using narrower = sse2;
+  using register_type = __m256i;
+  using mask_type = std::uint32_t;
+  static constexpr std::size_t width = 32;
+  static constexpr mask_type all = 0xFFFFFFFFU;
+
+  static auto load(const std::byte* p) noexcept -> register_type {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static void store(std::byte* p, register_type v) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+  static void stream(std::byte* p, register_type v) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+  static auto splat(std::byte b) noexcept -> register_type {
+    return _mm256_set1_epi8(static_cast<char>(b));
+  }
+  static auto eq(register_type a, register_type b) noexcept -> mask_type {
+    return static_cast<mask_type>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+  }
+  static auto msb(register_type v) noexcept -> mask_type {
+    return static_cast<mask_type>(_mm256_movemask_epi8(v));
+  }
+  template <std::size_t Size>
+  static auto byteswap(register_type v) noexcept -> register_type {
+    return _mm256_shuffle_epi8(v, load(byteswap_pattern<Size>.data()));
+  }
+};
+#endif
+
+#if defined(RANGE3_BYTE_SPAN_AVX512BW)
+struct avx512bw {
+  using narrower = avx2;
+  using register_type = __m512i;
+  using mask_type = std::uint64_t;
+  static constexpr std::size_t width = 64;
+  static constexpr mask_type all = ~mask_type{0};
+
+  static auto load(const std::byte* p) noexcept -> register_type {
+    return _mm512_loadu_si512(p);
+  }
+  static void store(std::byte* p, register_type v) noexcept {
+    _mm512_storeu_si512(p, v);
+  }
+  static void stream(std::byte* p, register_type v) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(p), v);
+  }
+  static auto splat(std::byte b) noexcept -> register_type {
+    return _mm512_set1_epi8(static_cast<char>(b));
+  }
+  static auto eq(register_type a, register_type b) noexcept -> mask_type {
+    return _mm512_cmpeq_epi8_mask(a, b);
+  }
+  static auto msb(register_type v) noexcept -> mask_type {
+    return _mm512_movepi8_mask(v);
+  }
+  template <std::size_t Size>
+  static auto byteswap(register_type v) noexcept -> register_type {
+    return _mm512_shuffle_epi8(v, load(byteswap_pattern<Size>.data()));
+  }
+};
+#endif
+
+// Orders preceding stream() stores before any later store.
+inline void fence() noexcept {
+#if defined(RANGE3_BYTE_SPAN_SSE2)
+  _mm_sfence();
+#endif
+}
+
+#if defined(RANGE3_BYTE_SPAN_AVX512BW)
+using native = avx512bw;
+#elif defined(RANGE3_BYTE_SPAN_AVX2)
+using native = avx2;
+#elif defined(RANGE3_BYTE_SPAN_SSE2)
+using native = sse2;
+#else
+using native = void;
+#endif
+
+}  // namespace range3::detail::simd
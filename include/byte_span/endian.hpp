@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/bit.hpp"
+#include "byte_span/detail/simd.hpp"
+
+namespace range3 {
+
+namespace detail {
+
+template <size_t Size>
+struct uint_of_size;
+template <>
+struct uint_of_size<1> {
+  using type = std::uint8_t;
+};
+template <>
+struct uint_of_size<2> {
+  using type = std::uint16_t;
+};
+template <>
+struct uint_of_size<4> {
+  using type = std::uint32_t;
+};
+template <>
+struct uint_of_size<8> {
+  using type = std::uint64_t;
+};
+
+// Integers, enumerations and floating-point types of 1, 2, 4 or 8 bytes.
+template <typename T>
+concept endian_value =
+    (std::integral<T> || std::is_enum_v<T> || std::floating_point<T>)
+    && !std::same_as<std::remove_cv_t<T>, bool>
+    && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <typename T, std::endian Order>
+constexpr auto load_endian(const std::byte* p) noexcept -> T {
+  using U = typename uint_of_size<sizeof(T)>::type;
+  U u = 0;
+  if (std::is_constant_evaluated()) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      auto const at = Order == std::endian::little ? sizeof(T) - 1 - i : i;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      u = static_cast<U>((u << 8U) | std::to_integer<U>(p[at]));
+    }
+  } else {
+    std::memcpy(&u, p, sizeof(T));
+    if constexpr (Order != std::endian::native) {
+      u = byteswap(u);
+    }
+  }
+  if constexpr (std::is_enum_v<T> || std::integral<T>) {
+    return static_cast<T>(u);
+  } else {
+    return std::bit_cast<T>(u);
+  }
+}
+
+template <std::endian Order, typename T>
+constexpr void store_endian(std::byte* p, T value) noexcept {
+  using U = typename uint_of_size<sizeof(T)>::type;
+  U u = 0;
+  if constexpr (std::is_enum_v<T> || std::integral<T>) {
+    u = static_cast<U>(value);
+  } else {
+    u = std::bit_cast<U>(value);
+  }
+  if (std::is_constant_evaluated()) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      auto const at = Order == std::endian::little ? i : sizeof(T) - 1 - i;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      p[at] = static_cast<std::byte>(u >> (8U * i));
+    }
+    return;
+  }
+  if constexpr (Order != std::endian::native) {
+    u = byteswap(u);
+  }
+  std::memcpy(p, &u, sizeof(T));
+}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// Reverses the bytes of `count` consecutive `Size`-byte elements from `in`
+// into `out`, which is either `in` itself or does not overlap it. Whole
+// registers first; the rest goes to the next narrower architecture, since an
+// overlapping tail load would swap some elements twice when in == out.
+// With -fsanitize=address GCC loses track of `count` and warns that the
+// register loads would overrun short arrays, though they are never reached.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+template <typename Arch, size_t Size>
+constexpr void byteswap_elements(const std::byte* in,
+                                 std::byte* out,
+                                 size_t count) noexcept {
+  using U = typename uint_of_size<Size>::type;
+  if constexpr (std::is_void_v<Arch>) {
+    for (size_t i = 0; i < count * Size; i += Size) {
+      store_value(out + i, byteswap(load_value<U>(in + i)));
+    }
+  } else {
+    constexpr auto width = Arch::width;
+    auto const n = count * Size;
+    size_t i = 0;
+    for (; i + width <= n; i += width) {
+      Arch::store(out + i, Arch::template byteswap<Size>(Arch::load(in + i)));
+    }
+    byteswap_elements<typename Arch::narrower, Size>(
+        in + i, out + i, (n - i) / Size);
+  }
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+template <size_t Size>
+constexpr void byteswap_elements(const std::byte* in,
+                                 std::byte* out,
+                                 size_t count) noexcept {
+  if (std::is_constant_evaluated()) {
+    byteswap_elements<void, Size>(in, out, count);
+  } else {
+    byteswap_elements<simd::native, Size>(in, out, count);
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// Loads T from `sizeof(T)` bytes at `offset`, stored least significant byte
+// first. No alignment is required.
+template <detail::endian_value T, typename B, size_t N>
+  requires(N == dynamic_extent || N >= sizeof(T))
+[[nodiscard]]
+constexpr auto load_le(byte_span<B, N> bytes, size_t offset = 0) noexcept
+    -> T {
+  assert(offset <= bytes.size() && bytes.size() - offset >= sizeof(T));
+  return detail::load_endian<T, std::endian::little>(bytes.data() + offset);
+}
+
+// Loads T from `sizeof(T)` bytes at `offset`, stored most significant byte
+// first. No alignment is required.
+template <detail::endian_value T, typename B, size_t N>
+  requires(N == dynamic_extent || N >= sizeof(T))
+[[nodiscard]]
+constexpr auto load_be(byte_span<B, N> bytes, size_t offset = 0) noexcept
+    -> T {
+  assert(offset <= bytes.size() && bytes.size() - offset >= sizeof(T));
+  return detail::load_endian<T, std::endian::big>(bytes.data() + offset);
+}
+
+template <detail::endian_value T, typename B, size_t N>
+  requires(!std::is_const_v<B>) && (N == dynamic_extent || N >= sizeof(T))
+constexpr void store_le(byte_span<B, N> bytes,
+                        T value,
+                        size_t offset = 0) noexcept {
+  assert(offset <= bytes.size() && bytes.size() - offset >= sizeof(T));
+  detail::store_endian<std::endian::little>(bytes.data() + offset, value);
+}
+
+template <detail::endian_value T, typename B, size_t N>
+  requires(!std::is_const_v<B>) && (N == dynamic_extent || N >= sizeof(T))
+constexpr void store_be(byte_span<B, N> bytes,
+                        T value,
+                        size_t offset = 0) noexcept {
+  assert(offset <= bytes.size() && bytes.size() - offset >= sizeof(T));
+  detail::store_endian<std::endian::big>(bytes.data() + offset, value);
+}
+
+// Static offsets into static extents are bounds-checked at compile time.
+template <detail::endian_value T, size_t Offset, typename B, size_t N>
+  requires(N != dynamic_extent && Offset <= N && N - Offset >= sizeof(T))
+[[nodiscard]]
+constexpr auto load_le(byte_span<B, N> bytes) noexcept -> T {
+  return detail::load_endian<T, std::endian::little>(bytes.data() + Offset);
+}
+
+template <detail::endian_value T, size_t Offset, typename B, size_t N>
+  requires(N != dynamic_extent && Offset <= N && N - Offset >= sizeof(T))
+[[nodiscard]]
+constexpr auto load_be(byte_span<B, N> bytes) noexcept -> T {
+  return detail::load_endian<T, std::endian::big>(bytes.data() + Offset);
+}
+
+template <detail::endian_value T, size_t Offset, typename B, size_t N>
+  requires(!std::is_const_v<B>) && (N != dynamic_extent && Offset <= N
+                                    && N - Offset >= sizeof(T))
+constexpr void store_le(byte_span<B, N> bytes, T value) noexcept {
+  detail::store_endian<std::endian::little>(bytes.data() + Offset, value);
+}
+
+template <detail::endian_value T, size_t Offset, typename B, size_t N>
+  requires(!std::is_const_v<B>) && (N != dynamic_extent && Offset <= N
+                                    && N - Offset >= sizeof(T))
+constexpr void store_be(byte_span<B, N> bytes, T value) noexcept {
+  detail::store_endian<std::endian::big>(bytes.data() + Offset, value);
+}
+
+// Reverses the byte order of every whole T in `bytes`, e.g. to turn an
+// array received in big-endian order into host order. Neither alignment nor
+// a size that is a multiple of sizeof(T) is required: trailing bytes that do
+// not form a whole T are left alone. Returns the number of elements swapped.
+// Vectorized with SSSE3/AVX2/AVX-512 shuffles where enabled.
+template <detail::endian_value T>
+constexpr auto byteswap_inplace(byte_view bytes) noexcept -> size_t {
+  auto const count = bytes.size() / sizeof(T);
+  if constexpr (sizeof(T) > 1) {
+    detail::byteswap_elements<sizeof(T)>(bytes.data(), bytes.data(), count);
+  }
+  return count;
+}
+
+// Copies the whole Ts of `in` that fit in `out`, reversing the byte order of
+// each, and returns their count. `in` and `out` may be the same memory but
+// must not otherwise overlap; neither needs to be aligned.
+template <detail::endian_value T>
+constexpr auto byteswap_copy(cbyte_view in, byte_view out) noexcept
+    -> size_t {
+  auto const count = std::min(in.size(), out.size()) / sizeof(T);
+  if constexpr (sizeof(T) > 1) {
+    detail::byteswap_elements<sizeof(T)>(in.data(), out.data(), count);
+  } else if (in.data() != out.data()) {
+    std::copy_n(in.data(), count, out.data());
+  }
+  return count;
+}
+
+}  // namespace range3
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+namespace range3 {
+
+// Error codes reported by the cursor and codec APIs.
+enum class byte_errc : unsigned char {
+  out_of_range = 1,      // fewer bytes remain than the operation needs
+  invalid_encoding = 2,  // the input is not a well-formed encoding
+};
+
+// Outcome of the text decoders (hex, Base64).
+struct decode_result {
+  std::size_t size{};    // bytes written
+  std::size_t offset{};  // characters consumed, or the first invalid one
+  byte_errc ec{};
+
+  constexpr explicit operator bool() const noexcept {
+    return ec == byte_errc{};
+  }
+};
+
+#if defined(__cpp_lib_expected)
+
+// Value or error returned by the checked cursors.
+template <typename T>
+using byte_result = std::expected<T, byte_errc>;
+using byte_unexpected = std::unexpected<byte_errc>;
+
+#else
+
+// Without std::expected (C++20), the checked cursors return this subset of
+// its interface. value() asserts instead of throwing.
+class byte_unexpected {
+ public:
+  constexpr explicit byte_unexpected(byte_errc ec) noexcept : ec_{ec} {}
+
+  [[nodiscard]]
+  constexpr auto error() const noexcept -> byte_errc {
+    return ec_;
+  }
+
+ private:
+  byte_errc ec_;
+};
+
+template <typename T>
+  requires std::is_void_v<T> || std::is_trivially_copyable_v<T>
+class byte_result {
+ public:
+  using value_type = T;
+  using error_type = byte_errc;
+
+  // NOLINTBEGIN(google-explicit-constructor, hicpp-explicit-conversions)
+  constexpr byte_result(const T& value) noexcept : value_{value} {}
+  constexpr byte_result(byte_unexpected e) noexcept
+      : empty_{}, ec_{e.error()} {}
+  // NOLINTEND(google-explicit-constructor, hicpp-explicit-conversions)
+
+  [[nodiscard]]
+  constexpr auto has_value() const noexcept -> bool {
+    return ec_ == byte_errc{};
+  }
+
+  constexpr explicit operator bool() const noexcept { return has_value(); }
+
+  [[nodiscard]]
+  constexpr auto value() const noexcept -> const T& {
+    assert(has_value());
+    return value_;
+  }
+
+  [[nodiscard]]
+  constexpr auto value() noexcept -> T& {
+    assert(has_value());
+    return value_;
+  }
+
+  [[nodiscard]]
+  constexpr auto error() const noexcept -> byte_errc {
+    assert(!has_value());
+    return ec_;
+  }
+
+  constexpr auto operator*() const noexcept -> const T& { return value(); }
+  constexpr auto operator*() noexcept -> T& { return value(); }
+  constexpr auto operator->() const noexcept -> const T* { return &value(); }
+  constexpr auto operator->() noexcept -> T* { return &value(); }
+
+ private:
+  union {
+    T value_;
+    char empty_;
+  };
+  byte_errc ec_{};
+};
+
+template <>
+class byte_result<void> {
+ public:
+  using value_type = void;
+  using error_type = byte_errc;
+
+  constexpr byte_result() noexcept = default;
+  // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+  constexpr byte_result(byte_unexpected e) noexcept : ec_{e.error()} {}
+
+  [[nodiscard]]
+  constexpr auto has_value() const noexcept -> bool {
+    return ec_ == byte_errc{};
+  }
+
+  constexpr explicit operator bool() const noexcept { return has_value(); }
+
+  constexpr void value() const noexcept { assert(has_value()); }
+
+  [[nodiscard]]
+  constexpr auto error() const noexcept -> byte_errc {
+    assert(!has_value());
+    return ec_;
+  }
+
+ private:
+  byte_errc ec_{};
+};
+
+#endif
+
+}  // namespace range3
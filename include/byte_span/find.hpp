@@ -0,0 +1,393 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/simd.hpp"
+
+namespace range3 {
+
+inline constexpr size_t npos = static_cast<size_t>(-1);
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+struct byte_equal {
+  std::byte value;
+
+  [[nodiscard]]
+  constexpr auto test(std::byte b) const noexcept -> bool {
+    return b == value;
+  }
+
+  template <typename Arch>
+  [[nodiscard]]
+  auto match(typename Arch::register_type v) const noexcept ->
+      typename Arch::mask_type {
+    return Arch::eq(v, Arch::splat(value));
+  }
+};
+
+// Membership in a set of bytes. Small sets are matched with one vector
+// compare per member; larger sets are only tested through a 256-bit table.
+class byte_set {
+ public:
+  static constexpr size_t max_vector_members = 16;
+
+  constexpr byte_set() noexcept = default;
+
+  constexpr explicit byte_set(const std::byte* members, size_t count) noexcept
+      : members_{members}, count_{count} {
+    if (!vectorizable()) {
+      for (size_t i = 0; i < count; ++i) {
+        auto const b = std::to_integer<unsigned>(members[i]);
+        table_[b / 64] |= std::uint64_t{1} << (b % 64);
+      }
+    }
+  }
+
+  [[nodiscard]]
+  constexpr auto vectorizable() const noexcept -> bool {
+    return count_ <= max_vector_members;
+  }
+
+  [[nodiscard]]
+  constexpr auto test(std::byte b) const noexcept -> bool {
+    if (vectorizable()) {
+      for (size_t i = 0; i < count_; ++i) {
+        if (members_[i] == b) {
+          return true;
+        }
+      }
+      return false;
+    }
+    auto const v = std::to_integer<unsigned>(b);
+    return ((table_[v / 64] >> (v % 64)) & 1U) != 0;
+  }
+
+  template <typename Arch>
+  [[nodiscard]]
+  auto match(typename Arch::register_type v) const noexcept ->
+      typename Arch::mask_type {
+    typename Arch::mask_type m = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      m |= Arch::eq(v, Arch::splat(members_[i]));
+    }
+    return m;
+  }
+
+ private:
+  const std::byte* members_ = nullptr;
+  size_t count_ = 0;
+  std::array<std::uint64_t, 4> table_{};
+};
+
+template <typename Pred>
+struct negated {
+  Pred pred;
+
+  [[nodiscard]]
+  constexpr auto test(std::byte b) const noexcept -> bool {
+    return !pred.test(b);
+  }
+
+  template <typename Arch>
+  [[nodiscard]]
+  auto match(typename Arch::register_type v) const noexcept ->
+      typename Arch::mask_type {
+    return ~pred.template match<Arch>(v) & Arch::all;
+  }
+};
+
+// Kernels return the offset of the first (last) byte satisfying `pred`, or
+// `n` when there is none. Inputs of at least one register are processed in
+// full registers, with the ragged end covered by one overlapping load; shorter
+// inputs are handed to the next narrower architecture.
+template <typename Arch, typename Pred>
+constexpr auto scan_forward(const std::byte* p,
+                            size_t n,
+                            const Pred& pred) noexcept -> size_t {
+  if constexpr (std::is_void_v<Arch>) {
+    for (size_t i = 0; i < n; ++i) {
+      if (pred.test(p[i])) {
+        return i;
+      }
+    }
+    return n;
+  } else {
+    constexpr auto width = Arch::width;
+    if (n < width) {
+      return scan_forward<typename Arch::narrower>(p, n, pred);
+    }
+    size_t i = 0;
+    for (; i + width <= n; i += width) {
+      auto const m = pred.template match<Arch>(Arch::load(p + i));
+      if (m != 0) {
+        return i + static_cast<size_t>(std::countr_zero(m));
+      }
+    }
+    if (i != n) {
+      i = n - width;
+      auto const m = pred.template match<Arch>(Arch::load(p + i));
+      if (m != 0) {
+        return i + static_cast<size_t>(std::countr_zero(m));
+      }
+    }
+    return n;
+  }
+}
+
+template <typename Arch, typename Pred>
+constexpr auto scan_backward(const std::byte* p,
+                             size_t n,
+                             const Pred& pred) noexcept -> size_t {
+  if constexpr (std::is_void_v<Arch>) {
+    for (size_t i = n; i != 0; --i) {
+      if (pred.test(p[i - 1])) {
+        return i - 1;
+      }
+    }
+    return n;
+  } else {
+    constexpr auto width = Arch::width;
+    if (n < width) {
+      return scan_backward<typename Arch::narrower>(p, n, pred);
+    }
+    size_t i = n;
+    while (i >= width) {
+      i -= width;
+      auto const m = pred.template match<Arch>(Arch::load(p + i));
+      if (m != 0) {
+        return i + static_cast<size_t>(std::bit_width(m)) - 1;
+      }
+    }
+    if (i != 0) {
+      auto const m = pred.template match<Arch>(Arch::load(p));
+      if (m != 0) {
+        return static_cast<size_t>(std::bit_width(m)) - 1;
+      }
+    }
+    return n;
+  }
+}
+
+template <typename Pred>
+constexpr auto find_if(cbyte_view bytes, size_t pos, const Pred& pred) noexcept
+    -> size_t {
+  if (pos >= bytes.size()) {
+    return npos;
+  }
+  auto const n = bytes.size() - pos;
+  auto const* const p = bytes.data() + pos;
+  size_t r = 0;
+  if (std::is_constant_evaluated()) {
+    r = scan_forward<void>(p, n, pred);
+  } else {
+    r = scan_forward<simd::native>(p, n, pred);
+  }
+  return r == n ? npos : pos + r;
+}
+
+template <typename Pred>
+constexpr auto find_last_if(cbyte_view bytes,
+                            size_t pos,
+                            const Pred& pred) noexcept -> size_t {
+  if (bytes.empty()) {
+    return npos;
+  }
+  auto const n = std::min(pos, bytes.size() - 1) + 1;
+  size_t r = 0;
+  if (std::is_constant_evaluated()) {
+    r = scan_backward<void>(bytes.data(), n, pred);
+  } else {
+    r = scan_backward<simd::native>(bytes.data(), n, pred);
+  }
+  return r == n ? npos : r;
+}
+
+template <typename Pred>
+constexpr auto find_in_set(cbyte_view bytes,
+                           size_t pos,
+                           const Pred& pred,
+                           bool vectorizable) noexcept -> size_t {
+  if (vectorizable || std::is_constant_evaluated()) {
+    return find_if(bytes, pos, pred);
+  }
+  if (pos >= bytes.size()) {
+    return npos;
+  }
+  auto const n = bytes.size() - pos;
+  auto const r = scan_forward<void>(bytes.data() + pos, n, pred);
+  return r == n ? npos : pos + r;
+}
+
+template <typename Pred>
+constexpr auto find_last_in_set(cbyte_view bytes,
+                                size_t pos,
+                                const Pred& pred,
+                                bool vectorizable) noexcept -> size_t {
+  if (vectorizable || std::is_constant_evaluated()) {
+    return find_last_if(bytes, pos, pred);
+  }
+  if (bytes.empty()) {
+    return npos;
+  }
+  auto const n = std::min(pos, bytes.size() - 1) + 1;
+  auto const r = scan_backward<void>(bytes.data(), n, pred);
+  return r == n ? npos : r;
+}
+
+// Offset of the first occurrence of the m-byte needle (m >= 2) in the n-byte
+// haystack, or n. Vector code compares the needle's first and last bytes
+// against every candidate position at once and only verifies the survivors.
+template <typename Arch>
+auto search_kernel(const std::byte* p,
+                   size_t n,
+                   const std::byte* needle,
+                   size_t m) noexcept -> size_t {
+  if (n < m) {
+    return n;
+  }
+  auto const positions = n - m + 1;
+  if constexpr (std::is_void_v<Arch>) {
+    for (size_t i = 0; i < positions; ++i) {
+      if (p[i] == needle[0] && std::memcmp(p + i + 1, needle + 1, m - 1) == 0) {
+        return i;
+      }
+    }
+    return n;
+  } else {
+    constexpr auto width = Arch::width;
+    if (positions < width) {
+      return search_kernel<typename Arch::narrower>(p, n, needle, m);
+    }
+    auto const first = Arch::splat(needle[0]);
+    auto const last = Arch::splat(needle[m - 1]);
+    auto const candidates = [&](size_t i) noexcept -> size_t {
+      auto mask = Arch::eq(Arch::load(p + i), first)
+                & Arch::eq(Arch::load(p + i + m - 1), last);
+      while (mask != 0) {
+        auto const j = i + static_cast<size_t>(std::countr_zero(mask));
+        if (std::memcmp(p + j + 1, needle + 1, m - 2) == 0) {
+          return j;
+        }
+        mask &= mask - 1;
+      }
+      return n;
+    };
+    size_t i = 0;
+    for (; i + width <= positions; i += width) {
+      if (auto const r = candidates(i); r != n) {
+        return r;
+      }
+    }
+    if (i != positions) {
+      return candidates(positions - width);
+    }
+    return n;
+  }
+}
+
+constexpr auto find_sequence(cbyte_view bytes,
+                             cbyte_view needle,
+                             size_t pos) noexcept -> size_t {
+  if (pos > bytes.size() || needle.size() > bytes.size() - pos) {
+    return npos;
+  }
+  if (needle.empty()) {
+    return pos;
+  }
+  if (needle.size() == 1) {
+    return find_if(bytes, pos, byte_equal{needle[0]});
+  }
+  auto const* const p = bytes.data() + pos;
+  auto const n = bytes.size() - pos;
+  size_t r = n;
+  if (std::is_constant_evaluated()) {
+    for (size_t i = 0; i + needle.size() <= n && r == n; ++i) {
+      size_t k = 0;
+      while (k < needle.size() && p[i + k] == needle[k]) {
+        ++k;
+      }
+      r = k == needle.size() ? i : n;
+    }
+  } else {
+    r = search_kernel<simd::native>(p, n, needle.data(), needle.size());
+  }
+  return r == n ? npos : pos + r;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// Offset of the first `value` at or after `pos`, or npos.
+[[nodiscard]]
+constexpr auto find(cbyte_view bytes, std::byte value, size_t pos = 0) noexcept
+    -> size_t {
+  return detail::find_if(bytes, pos, detail::byte_equal{value});
+}
+
+// Offset of the first occurrence of `needle` at or after `pos`, or npos. An
+// empty needle is found at `pos` itself.
+[[nodiscard]]
+constexpr auto find(cbyte_view bytes,
+                    cbyte_view needle,
+                    size_t pos = 0) noexcept -> size_t {
+  return detail::find_sequence(bytes, needle, pos);
+}
+
+// Offset of the last `value` at or before `pos`, or npos.
+[[nodiscard]]
+constexpr auto rfind(cbyte_view bytes,
+                     std::byte value,
+                     size_t pos = npos) noexcept -> size_t {
+  return detail::find_last_if(bytes, pos, detail::byte_equal{value});
+}
+
+// Offset of the first byte at or after `pos` that is contained in `set`.
+[[nodiscard]]
+constexpr auto find_first_of(cbyte_view bytes,
+                             cbyte_view set,
+                             size_t pos = 0) noexcept -> size_t {
+  auto const s = detail::byte_set{set.data(), set.size()};
+  return detail::find_in_set(bytes, pos, s, s.vectorizable());
+}
+
+// Offset of the first byte at or after `pos` that is not contained in `set`.
+[[nodiscard]]
+constexpr auto find_first_not_of(cbyte_view bytes,
+                                 cbyte_view set,
+                                 size_t pos = 0) noexcept -> size_t {
+  auto const s = detail::byte_set{set.data(), set.size()};
+  return detail::find_in_set(
+      bytes, pos, detail::negated<detail::byte_set>{s}, s.vectorizable());
+}
+
+// Offset of the last byte at or before `pos` that is contained in `set`.
+[[nodiscard]]
+constexpr auto find_last_of(cbyte_view bytes,
+                            cbyte_view set,
+                            size_t pos = npos) noexcept -> size_t {
+  auto const s = detail::byte_set{set.data(), set.size()};
+  return detail::find_last_in_set(bytes, pos, s, s.vectorizable());
+}
+
+// Offset of the last byte at or before `pos` that is not contained in `set`.
+[[nodiscard]]
+constexpr auto find_last_not_of(cbyte_view bytes,
+                                cbyte_view set,
+                                size_t pos = npos) noexcept -> size_t {
+  auto const s = detail::byte_set{set.data(), set.size()};
+  return detail::find_last_in_set(
+      bytes, pos, detail::negated<detail::byte_set>{s}, s.vectorizable());
+}
+
+}  // namespace range3
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/compare.hpp"
+#include "byte_span/detail/bit.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace range3 {
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// The 64-bit hash follows the structure of wyhash (final4): 48-byte stripes
+// over three independent lanes, 16-byte rounds for the remainder and an
+// overlapping read of the last 16 bytes. It is not bit-compatible with any
+// published wyhash release and must not be persisted.
+inline constexpr std::array<std::uint64_t, 4> wy_secret = {
+    0x2d358dccaa6c78a5ULL,
+    0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL,
+};
+
+constexpr void wy_mum(std::uint64_t& a, std::uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128;  // NOLINT
+  auto const r = static_cast<uint128>(a) * b;
+  a = static_cast<std::uint64_t>(r);
+  b = static_cast<std::uint64_t>(r >> 64U);
+#else
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+  if (!std::is_constant_evaluated()) {
+    a = _umul128(a, b, &b);
+    return;
+  }
+#endif
+  auto const ha = a >> 32U;
+  auto const hb = b >> 32U;
+  auto const la = a & 0xFFFFFFFFU;
+  auto const lb = b & 0xFFFFFFFFU;
+  auto const rh = ha * hb;
+  auto const rm0 = ha * lb;
+  auto const rm1 = hb * la;
+  auto const rl = la * lb;
+  auto const t = rl + (rm0 << 32U);
+  auto c = static_cast<std::uint64_t>(t < rl);
+  auto const lo = t + (rm1 << 32U);
+  c += static_cast<std::uint64_t>(lo < t);
+  a = lo;
+  b = rh + (rm0 >> 32U) + (rm1 >> 32U) + c;
+#endif
+}
+
+constexpr auto wy_mix(std::uint64_t a, std::uint64_t b) noexcept
+    -> std::uint64_t {
+  wy_mum(a, b);
+  return a ^ b;
+}
+
+constexpr auto wy_r8(const std::byte* p) noexcept -> std::uint64_t {
+  return read_le<std::uint64_t>(p);
+}
+
+constexpr auto wy_r4(const std::byte* p) noexcept -> std::uint64_t {
+  return read_le<std::uint32_t>(p);
+}
+
+// One, two or three bytes, read without branching on the length.
+constexpr auto wy_r3(const std::byte* p, size_t k) noexcept -> std::uint64_t {
+  return (std::to_integer<std::uint64_t>(p[0]) << 16U)
+       | (std::to_integer<std::uint64_t>(p[k >> 1U]) << 8U)
+       | std::to_integer<std::uint64_t>(p[k - 1]);
+}
+
+constexpr auto wy_seed(std::uint64_t seed) noexcept -> std::uint64_t {
+  return seed ^ wy_mix(seed ^ wy_secret[0], wy_secret[1]);
+}
+
+constexpr auto wy_final(std::uint64_t a,
+                        std::uint64_t b,
+                        std::uint64_t seed,
+                        size_t len) noexcept -> std::uint64_t {
+  a ^= wy_secret[1];
+  b ^= seed;
+  wy_mum(a, b);
+  return wy_mix(a ^ wy_secret[0] ^ len, b ^ wy_secret[1]);
+}
+
+// Keys of at most 16 bytes.
+constexpr auto wy_short(const std::byte* p,
+                        size_t len,
+                        std::uint64_t seed) noexcept -> std::uint64_t {
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  if (len >= 4) {
+    auto const shift = (len >> 3U) << 2U;
+    a = (wy_r4(p) << 32U) | wy_r4(p + shift);
+    b = (wy_r4(p + len - 4) << 32U) | wy_r4(p + len - 4 - shift);
+  } else if (len > 0) {
+    a = wy_r3(p, len);
+  }
+  return wy_final(a, b, seed, len);
+}
+
+struct wy_lanes {
+  std::uint64_t seed;
+  std::uint64_t see1;
+  std::uint64_t see2;
+};
+
+constexpr void wy_stripe(const std::byte* p, wy_lanes& s) noexcept {
+  s.seed = wy_mix(wy_r8(p) ^ wy_secret[1], wy_r8(p + 8) ^ s.seed);
+  s.see1 = wy_mix(wy_r8(p + 16) ^ wy_secret[2], wy_r8(p + 24) ^ s.see1);
+  s.see2 = wy_mix(wy_r8(p + 32) ^ wy_secret[3], wy_r8(p + 40) ^ s.see2);
+}
+
+// Finishes a key of more than 16 bytes once fewer than 48 bytes remain at p.
+// The final read may reach up to 16 bytes before p.
+constexpr auto wy_tail(const std::byte* p,
+                       size_t remaining,
+                       std::uint64_t seed,
+                       size_t len) noexcept -> std::uint64_t {
+  while (remaining > 16) {
+    seed = wy_mix(wy_r8(p) ^ wy_secret[1], wy_r8(p + 8) ^ seed);
+    remaining -= 16;
+    p += 16;
+  }
+  return wy_final(
+      wy_r8(p + remaining - 16), wy_r8(p + remaining - 8), seed, len);
+}
+
+constexpr auto wy_hash(const std::byte* p,
+                       size_t len,
+                       std::uint64_t seed) noexcept -> std::uint64_t {
+  seed = wy_seed(seed);
+  if (len <= 16) {
+    return wy_short(p, len, seed);
+  }
+  auto remaining = len;
+  if (remaining >= 48) {
+    auto s = wy_lanes{seed, seed, seed};
+    do {
+      wy_stripe(p, s);
+      p += 48;
+      remaining -= 48;
+    } while (remaining >= 48);
+    seed = s.seed ^ s.see1 ^ s.see2;
+  }
+  return wy_tail(p, remaining, seed, len);
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// 64-bit non-cryptographic hash of a byte sequence. Values depend only on the
+// bytes and the seed, not on the extent or how the input was segmented.
+[[nodiscard]]
+constexpr auto hash64(cbyte_view bytes, std::uint64_t seed = 0) noexcept
+    -> std::uint64_t {
+  return detail::wy_hash(bytes.data(), bytes.size(), seed);
+}
+
+// Static extents select the short-key path at compile time.
+template <typename B, size_t N>
+  requires(N != dynamic_extent)
+[[nodiscard]]
+constexpr auto hash64(byte_span<B, N> bytes, std::uint64_t seed = 0) noexcept
+    -> std::uint64_t {
+  if constexpr (N <= 16) {
+    return detail::wy_short(bytes.data(), N, detail::wy_seed(seed));
+  } else {
+    return detail::wy_hash(bytes.data(), N, seed);
+  }
+}
+
+// Incremental form of hash64: feeding the same bytes in any segmentation
+// yields the same digest as hashing them in one piece.
+class hasher {
+ public:
+  constexpr explicit hasher(std::uint64_t seed = 0) noexcept
+      : lanes_{detail::wy_seed(seed), 0, 0} {
+    lanes_.see1 = lanes_.seed;
+    lanes_.see2 = lanes_.seed;
+  }
+
+  constexpr auto update(cbyte_view bytes) noexcept -> hasher& {
+    auto const* p = bytes.data();
+    auto n = bytes.size();
+    total_ += n;
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (pending_ != 0) {
+      auto const take = std::min(n, stripe - pending_);
+      copy_bytes(buffer_.data() + history + pending_, p, take);
+      pending_ += take;
+      p += take;
+      n -= take;
+      if (pending_ < stripe) {
+        return *this;
+      }
+      detail::wy_stripe(buffer_.data() + history, lanes_);
+      striped_ = true;
+      pending_ = 0;
+      copy_bytes(buffer_.data(), buffer_.data() + stripe, history);
+    }
+    if (n >= stripe) {
+      do {
+        detail::wy_stripe(p, lanes_);
+        p += stripe;
+        n -= stripe;
+      } while (n >= stripe);
+      striped_ = true;
+      copy_bytes(buffer_.data(), p - history, history);
+    }
+    copy_bytes(buffer_.data() + history, p, n);
+    pending_ = n;
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return *this;
+  }
+
+  [[nodiscard]]
+  constexpr auto digest() const noexcept -> std::uint64_t {
+    auto const* p = buffer_.data() + history;
+    if (!striped_) {
+      if (total_ <= 16) {
+        return detail::wy_short(p, total_, lanes_.seed);
+      }
+      return detail::wy_tail(p, pending_, lanes_.seed, total_);
+    }
+    return detail::wy_tail(
+        p, pending_, lanes_.seed ^ lanes_.see1 ^ lanes_.see2, total_);
+  }
+
+ private:
+  static constexpr size_t stripe = 48;
+  static constexpr size_t history = 16;
+
+  static constexpr void copy_bytes(std::byte* dst,
+                                   const std::byte* src,
+                                   size_t n) noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::copy_n(src, n, dst);
+  }
+
+  // [0, history) keeps the tail of the last stripe for the final read,
+  // [history, history + stripe) collects the next stripe.
+  std::array<std::byte, history + stripe> buffer_{};
+  detail::wy_lanes lanes_;
+  size_t pending_{};
+  size_t total_{};
+  bool striped_{};
+};
+
+// Transparent equality for unordered containers keyed on byte views, to pair
+// with the std::hash specialization below.
+struct byte_span_equal {
+  using is_transparent = void;
+
+  [[nodiscard]]
+  constexpr auto operator()(cbyte_view lhs, cbyte_view rhs) const noexcept
+      -> bool {
+    return equal(lhs, rhs);
+  }
+};
+
+}  // namespace range3
+
+// Transparent so that containers keyed on byte_span can be probed with
+// std::string_view, std::span<const std::byte>, std::vector<char> or anything
+// else that converts to cbyte_view.
+template <typename B, size_t N>
+struct std::hash<range3::byte_span<B, N>> {
+  using is_transparent = void;
+
+  [[nodiscard]]
+  auto operator()(range3::cbyte_view bytes) const noexcept -> size_t {
+    return static_cast<size_t>(range3::hash64(bytes));
+  }
+};
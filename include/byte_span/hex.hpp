@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/simd.hpp"
+#include "byte_span/error.hpp"
+
+namespace range3 {
+
+enum class hex_case : unsigned char { lower, upper };
+
+[[nodiscard]]
+constexpr auto hex_encoded_size(size_t bytes) noexcept -> size_t {
+  return 2 * bytes;
+}
+
+// Bytes decoded from `chars` hex digits. An odd count does not decode.
+[[nodiscard]]
+constexpr auto hex_decoded_size(size_t chars) noexcept -> size_t {
+  return chars / 2;
+}
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+inline constexpr std::string_view hex_digits_lower = "0123456789abcdef";
+inline constexpr std::string_view hex_digits_upper = "0123456789ABCDEF";
+
+// Digit value of each character, or 0xFF
+inline constexpr auto hex_values = [] {
+  std::array<std::uint8_t, 256> table{};
+  table.fill(0xFF);
+  for (std::uint8_t i = 0; i < 10; ++i) {
+    table[size_t{'0'} + i] = i;
+  }
+  for (std::uint8_t i = 0; i < 6; ++i) {
+    table[size_t{'a'} + i] = static_cast<std::uint8_t>(10 + i);
+    table[size_t{'A'} + i] = static_cast<std::uint8_t>(10 + i);
+  }
+  return table;
+}();
+
+// Encodes from byte `at` on.
+constexpr void hex_encode_scalar(const std::byte* in,
+                                 size_t n,
+                                 std::byte* out,
+                                 std::string_view digits,
+                                 size_t at) noexcept {
+  for (size_t i = at; i < n; ++i) {
+    auto const b = std::to_integer<unsigned>(in[i]);
+    out[2 * i] = static_cast<std::byte>(digits[b >> 4U]);
+    out[(2 * i) + 1] = static_cast<std::byte>(digits[b & 0xFU]);
+  }
+}
+
+// Decodes pairs from `at`; stops at the first invalid digit.
+constexpr auto hex_decode_scalar(const std::byte* in,
+                                 size_t n,
+                                 std::byte* out,
+                                 size_t at) noexcept -> decode_result {
+  for (; n - at >= 2; at += 2) {
+    auto const hi = hex_values[std::to_integer<size_t>(in[at])];
+    auto const lo = hex_values[std::to_integer<size_t>(in[at + 1])];
+    if ((hi | lo) > 0xF) [[unlikely]] {
+      return {at / 2, hi > 0xF ? at : at + 1, byte_errc::invalid_encoding};
+    }
+    out[at / 2] = static_cast<std::byte>((hi << 4U) | lo);
+  }
+  if (at != n) {
+    return {at / 2, at, byte_errc::out_of_range};
+  }
+  return {at / 2, at, {}};
+}
+
+#if defined(RANGE3_BYTE_SPAN_AVX2)
+
+// 32 input bytes per iteration: split into nibbles, interleave them and map
+// each nibble to its digit with one in-register table lookup.
+inline auto hex_encode_avx2(const std::byte* in,
+                            size_t n,
+                            std::byte* out,
+                            std::string_view digits) noexcept -> size_t {
+  auto const lut = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits.data())));
+  auto const low4 = _mm256_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; n - i >= 32; i += 32) {
+    auto const v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    auto const hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low4);
+    auto const lo = _mm256_and_si256(v, low4);
+    // Per 128-bit lane: a holds bytes 0-7 and b bytes 8-15, as digit pairs.
+    auto const a = _mm256_shuffle_epi8(lut, _mm256_unpacklo_epi8(hi, lo));
+    auto const b = _mm256_shuffle_epi8(lut, _mm256_unpackhi_epi8(hi, lo));
+    auto* dst = reinterpret_cast<__m256i*>(out + (2 * i));
+    _mm256_storeu_si256(dst, _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  return i;
+}
+
+// 32 digits per iteration. Returns the number of digits consumed; a block
+// holding an invalid character is left to the scalar decoder, which locates
+// it.
+inline auto hex_decode_avx2(const std::byte* in,
+                            size_t n,
+                            std::byte* out) noexcept -> size_t {
+  auto const in_range = [](__m256i v, char first, char count) {
+    auto const d = _mm256_sub_epi8(v, _mm256_set1_epi8(first));
+    auto const ok = _mm256_cmpeq_epi8(
+        _mm256_min_epu8(d, _mm256_set1_epi8(count)), d);
+    return std::pair{d, ok};
+  };
+  size_t i = 0;
+  for (; n - i >= 32; i += 32) {
+    auto const v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    auto const [digit, is_digit] = in_range(v, '0', 9);
+    auto const [alpha, is_alpha] =
+        in_range(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 5);
+    if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) != -1) {
+      break;
+    }
+    auto const nibbles = _mm256_blendv_epi8(
+        _mm256_add_epi8(alpha, _mm256_set1_epi8(10)), digit, is_digit);
+    // (hi, lo) pairs -> hi * 16 + lo in each 16-bit lane
+    auto const words =
+        _mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110));
+    auto const packed = _mm256_permute4x64_epi64(
+        _mm256_packus_epi16(words, words), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (i / 2)),
+                     _mm256_castsi256_si128(packed));
+  }
+  return i;
+}
+
+#endif
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// Writes the hex digits of `bytes` to the front of `out`, which must hold
+// hex_encoded_size(bytes.size()) characters. Returns the count written.
+constexpr auto hex_encode(cbyte_view bytes,
+                          byte_view out,
+                          hex_case letters = hex_case::lower) noexcept
+    -> size_t {
+  assert(out.size() >= hex_encoded_size(bytes.size()));
+  auto const digits = letters == hex_case::lower ? detail::hex_digits_lower
+                                                 : detail::hex_digits_upper;
+  size_t done = 0;
+#if defined(RANGE3_BYTE_SPAN_AVX2)
+  if (!std::is_constant_evaluated()) {
+    done = detail::hex_encode_avx2(
+        bytes.data(), bytes.size(), out.data(), digits);
+  }
+#endif
+  detail::hex_encode_scalar(
+      bytes.data(), bytes.size(), out.data(), digits, done);
+  return hex_encoded_size(bytes.size());
+}
+
+[[nodiscard]]
+inline auto to_hex(cbyte_view bytes, hex_case letters = hex_case::lower)
+    -> std::string {
+  std::string out(hex_encoded_size(bytes.size()), '\0');
+  hex_encode(bytes, byte_view{out}, letters);
+  return out;
+}
+
+// Decodes hex digits of either case into the front of `out`, which must
+// hold hex_decoded_size(chars.size()) bytes. An invalid character reports
+// byte_errc::invalid_encoding with `offset` at that character; an odd
+// trailing digit reports byte_errc::out_of_range. `size` counts the bytes
+// written before the error.
+constexpr auto hex_decode(cbyte_view chars, byte_view out) noexcept
+    -> decode_result {
+  assert(out.size() >= hex_decoded_size(chars.size()));
+  size_t done = 0;
+#if defined(RANGE3_BYTE_SPAN_AVX2)
+  if (!std::is_constant_evaluated()) {
+    done = detail::hex_decode_avx2(chars.data(), chars.size(), out.data());
+  }
+#endif
+  return detail::hex_decode_scalar(
+      chars.data(), chars.size(), out.data(), done);
+}
+
+}  // namespace range3
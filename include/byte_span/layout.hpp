@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/bit.hpp"
+#include "byte_span/endian.hpp"
+
+namespace range3 {
+
+// A field of type T at byte `Offset` of a fixed binary record, stored in
+// `Order`. Integers, enumerations and floating-point types may have any byte
+// order; other trivially copyable types (e.g. std::array<char, 8>) are
+// copied as they are and must use std::endian::native. Declare one alias per
+// field to give it a name:
+//
+//   using magic = range3::be_field<std::uint32_t, 0>;
+template <typename T, size_t Offset, std::endian Order = std::endian::native>
+  requires detail::endian_value<T>
+        || (std::is_trivially_copyable_v<T> && Order == std::endian::native)
+struct field {
+  using value_type = T;
+  static constexpr size_t offset = Offset;
+  static constexpr size_t size = sizeof(T);
+  static constexpr std::endian order = Order;
+};
+
+template <typename T, size_t Offset>
+using le_field = field<T, Offset, std::endian::little>;
+
+template <typename T, size_t Offset>
+using be_field = field<T, Offset, std::endian::big>;
+
+namespace detail {
+
+template <typename F>
+inline constexpr bool is_field_v = false;
+template <typename T, size_t Offset, std::endian Order>
+inline constexpr bool is_field_v<field<T, Offset, Order>> = true;
+
+// `F` lies within the first `Size` bytes.
+template <typename F, size_t Size>
+concept field_within =
+    is_field_v<F> && F::offset <= Size && Size - F::offset >= F::size;
+
+template <typename... Fields>
+constexpr auto fields_disjoint() noexcept -> bool {
+  constexpr std::array<size_t, sizeof...(Fields)> begin{Fields::offset...};
+  constexpr std::array<size_t, sizeof...(Fields)> end{
+      (Fields::offset + Fields::size)...};
+  for (size_t i = 0; i < begin.size(); ++i) {
+    for (size_t j = i + 1; j < begin.size(); ++j) {
+      if (begin[i] < end[j] && begin[j] < end[i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace detail
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// Reads field `F` of a record. The extent must be static and hold the
+// field, so the bounds are proven at compile time; the access is a single
+// (byte-swapping) load.
+template <typename F, typename B, size_t N>
+  requires(N != dynamic_extent) && detail::field_within<F, N>
+[[nodiscard]]
+constexpr auto get(byte_span<B, N> bytes) noexcept -> typename F::value_type {
+  using T = typename F::value_type;
+  if constexpr (detail::endian_value<T>) {
+    return detail::load_endian<T, F::order>(bytes.data() + F::offset);
+  } else {
+    return detail::load_value<T>(bytes.data() + F::offset);
+  }
+}
+
+// Writes field `F` of a record, with the same compile-time bounds check.
+template <typename F, typename B, size_t N>
+  requires(!std::is_const_v<B>) && (N != dynamic_extent)
+       && detail::field_within<F, N>
+constexpr void set(byte_span<B, N> bytes,
+                   const typename F::value_type& value) noexcept {
+  if constexpr (detail::endian_value<typename F::value_type>) {
+    detail::store_endian<F::order>(bytes.data() + F::offset, value);
+  } else {
+    detail::store_value(bytes.data() + F::offset, value);
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// The bytes of field `F`, e.g. to compare a magic number or hand a name on.
+template <typename F, typename B, size_t N>
+  requires(N != dynamic_extent) && detail::field_within<F, N>
+[[nodiscard]]
+constexpr auto field_bytes(byte_span<B, N> bytes) noexcept
+    -> byte_span<B, F::size> {
+  return bytes.template subspan<F::offset, F::size>();
+}
+
+// A record of `Size` bytes made of `Fields`. Fields that run past the end or
+// overlap one another make the layout ill-formed. Its get() and set() only
+// accept byte_span<B, Size> and fields of this layout:
+//
+//   using header = range3::layout<64, magic, version, length>;
+//   auto const n = header::get<length>(bytes);  // byte_span<const B, 64>
+template <size_t Size, typename... Fields>
+  requires(Size != dynamic_extent)
+       && (detail::field_within<Fields, Size> && ...)
+       && (detail::fields_disjoint<Fields...>())
+struct layout {
+  static constexpr size_t size = Size;
+
+  template <typename F>
+  static constexpr bool contains = (std::is_same_v<F, Fields> || ...);
+
+  template <typename F, typename B>
+    requires contains<F>
+  [[nodiscard]]
+  static constexpr auto get(byte_span<B, Size> bytes) noexcept ->
+      typename F::value_type {
+    return range3::get<F>(bytes);
+  }
+
+  template <typename F, typename B>
+    requires contains<F> && (!std::is_const_v<B>)
+  static constexpr void set(byte_span<B, Size> bytes,
+                            const typename F::value_type& value) noexcept {
+    range3::set<F>(bytes, value);
+  }
+};
+
+}  // namespace range3
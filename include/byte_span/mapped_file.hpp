@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include "byte_span/byte_span.hpp"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "byte_span/mapped_file.hpp requires POSIX mmap"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace range3 {
+
+enum class map_mode : unsigned char { read_only, read_write };
+
+// Access pattern hints passed to madvise. Hints the platform does not know
+// are reported as std::errc::not_supported.
+enum class map_advice : unsigned char {
+  normal,
+  sequential,
+  random,
+  willneed,
+  dontneed,
+  hugepage,
+};
+
+enum class sync_mode : unsigned char { wait, async };
+
+// A file opened and mapped into memory, or a window of one. The mapping is
+// shared: writes through a read_write map reach the file, and sync() forces
+// them out. Errors are reported std::filesystem style: the throwing
+// overloads raise std::system_error, the std::error_code overloads do not
+// throw.
+class mapped_file {
+ public:
+  // Length that maps up to the end of the file
+  static constexpr size_t to_end = std::numeric_limits<size_t>::max();
+
+  mapped_file() noexcept = default;
+
+  explicit mapped_file(const std::filesystem::path& path,
+                       map_mode mode = map_mode::read_only)
+      : mapped_file{path, mode, 0, to_end} {}
+
+  // Maps only `length` bytes from `offset`, which need not be page aligned.
+  mapped_file(const std::filesystem::path& path,
+              map_mode mode,
+              std::uint64_t offset,
+              size_t length) {
+    std::error_code ec;
+    open(path, mode, offset, length, ec);
+    if (ec) {
+      throw std::system_error{ec, path.string()};
+    }
+  }
+
+  mapped_file(const std::filesystem::path& path,
+              map_mode mode,
+              std::error_code& ec) noexcept {
+    open(path, mode, 0, to_end, ec);
+  }
+
+  mapped_file(const std::filesystem::path& path,
+              map_mode mode,
+              std::uint64_t offset,
+              size_t length,
+              std::error_code& ec) noexcept {
+    open(path, mode, offset, length, ec);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  auto operator=(const mapped_file&) -> mapped_file& = delete;
+
+  mapped_file(mapped_file&& other) noexcept
+      : fd_{std::exchange(other.fd_, -1)},
+        mode_{other.mode_},
+        file_size_{std::exchange(other.file_size_, 0)},
+        offset_{std::exchange(other.offset_, 0)},
+        base_{std::exchange(other.base_, nullptr)},
+        mapped_{std::exchange(other.mapped_, 0)},
+        data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  auto operator=(mapped_file&& other) noexcept -> mapped_file& {
+    if (this != &other) {
+      close();
+      fd_ = std::exchange(other.fd_, -1);
+      mode_ = other.mode_;
+      file_size_ = std::exchange(other.file_size_, 0);
+      offset_ = std::exchange(other.offset_, 0);
+      base_ = std::exchange(other.base_, nullptr);
+      mapped_ = std::exchange(other.mapped_, 0);
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~mapped_file() { close(); }
+
+  [[nodiscard]]
+  auto is_open() const noexcept -> bool {
+    return fd_ != -1;
+  }
+
+  [[nodiscard]]
+  auto mode() const noexcept -> map_mode {
+    return mode_;
+  }
+
+  // Size of the whole file when it was opened
+  [[nodiscard]]
+  auto file_size() const noexcept -> std::uint64_t {
+    return file_size_;
+  }
+
+  // Position of the mapped window within the file
+  [[nodiscard]]
+  auto offset() const noexcept -> std::uint64_t {
+    return offset_;
+  }
+
+  [[nodiscard]]
+  auto size() const noexcept -> size_t {
+    return size_;
+  }
+
+  [[nodiscard]]
+  auto bytes() const noexcept -> cbyte_view {
+    return cbyte_view{data_, size_};
+  }
+
+  // Empty for a read_only map, whose pages cannot be written.
+  [[nodiscard]]
+  auto writable_bytes() noexcept -> byte_view {
+    if (mode_ != map_mode::read_write) {
+      return {};
+    }
+    return byte_view{data_, size_};
+  }
+
+  // Moves the window, keeping the file open. The file size is read again,
+  // so a window can follow a growing file.
+  void remap(std::uint64_t offset, size_t length) {
+    std::error_code ec;
+    remap(offset, length, ec);
+    if (ec) {
+      throw std::system_error{ec, "mapped_file::remap"};
+    }
+  }
+
+  void remap(std::uint64_t offset,
+             size_t length,
+             std::error_code& ec) noexcept {
+    assert(is_open());
+    unmap();
+    if (stat(ec)) {
+      map(offset, length, ec);
+    }
+  }
+
+  // Hint for the whole window, or for `length` bytes from `offset` within it.
+  // Hints never fail the mapping, so they only report errors.
+  auto advise(map_advice advice,
+              size_t offset = 0,
+              size_t length = to_end) const noexcept -> std::error_code {
+    assert(offset <= size_);
+    auto const flag = native_advice(advice);
+    if (flag == -1) {
+      return std::make_error_code(std::errc::not_supported);
+    }
+    length = std::min(length, size_ - offset);
+    if (length == 0) {
+      return {};
+    }
+    auto const [begin, span] = page_range(offset, length);
+    if (::madvise(begin, span, flag) != 0) {
+      return {errno, std::system_category()};
+    }
+    return {};
+  }
+
+  // Writes dirty pages of a read_write window back to the file.
+  void sync(sync_mode how = sync_mode::wait) const {
+    std::error_code ec;
+    sync(how, ec);
+    if (ec) {
+      throw std::system_error{ec, "mapped_file::sync"};
+    }
+  }
+
+  void sync(sync_mode how, std::error_code& ec) const noexcept {
+    ec.clear();
+    if (mapped_ == 0) {
+      return;
+    }
+    auto const flags = how == sync_mode::wait ? MS_SYNC : MS_ASYNC;
+    if (::msync(base_, mapped_, flags) != 0) {
+      ec.assign(errno, std::system_category());
+    }
+  }
+
+  void close() noexcept {
+    unmap();
+    if (fd_ != -1) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    file_size_ = 0;
+  }
+
+ private:
+  static auto page_size() noexcept -> size_t {
+    static auto const size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  static auto native_advice(map_advice advice) noexcept -> int {
+    switch (advice) {
+      case map_advice::normal:
+        return MADV_NORMAL;
+      case map_advice::sequential:
+        return MADV_SEQUENTIAL;
+      case map_advice::random:
+        return MADV_RANDOM;
+      case map_advice::willneed:
+        return MADV_WILLNEED;
+      case map_advice::dontneed:
+        return MADV_DONTNEED;
+      case map_advice::hugepage:
+#if defined(MADV_HUGEPAGE)
+        return MADV_HUGEPAGE;
+#else
+        return -1;
+#endif
+    }
+    return -1;
+  }
+
+  // madvise wants a page-aligned start
+  auto page_range(size_t offset, size_t length) const noexcept
+      -> std::pair<void*, size_t> {
+    auto const from = static_cast<size_t>(data_ - base_) + offset;
+    auto const aligned = from - (from % page_size());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return {base_ + aligned, from + length - aligned};
+  }
+
+  void open(const std::filesystem::path& path,
+            map_mode mode,
+            std::uint64_t offset,
+            size_t length,
+            std::error_code& ec) noexcept {
+    ec.clear();
+    mode_ = mode;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    fd_ = ::open(path.c_str(),
+                 (mode == map_mode::read_only ? O_RDONLY : O_RDWR) | O_CLOEXEC);
+    if (fd_ == -1) {
+      ec.assign(errno, std::system_category());
+      return;
+    }
+    if (stat(ec)) {
+      map(offset, length, ec);
+    }
+    if (ec) {
+      close();
+    }
+  }
+
+  auto stat(std::error_code& ec) noexcept -> bool {
+    struct ::stat st {};
+    if (::fstat(fd_, &st) != 0) {
+      ec.assign(errno, std::system_category());
+      return false;
+    }
+    file_size_ = static_cast<std::uint64_t>(st.st_size);
+    return true;
+  }
+
+  void map(std::uint64_t offset, size_t length, std::error_code& ec) noexcept {
+    ec.clear();
+    if (offset > file_size_) {
+      ec = std::make_error_code(std::errc::invalid_argument);
+      return;
+    }
+    auto const available = file_size_ - offset;
+    if (available > std::numeric_limits<size_t>::max()
+        && length == to_end)
+    {
+      ec = std::make_error_code(std::errc::value_too_large);
+      return;
+    }
+    length = static_cast<size_t>(
+        std::min<std::uint64_t>(length, available));
+    offset_ = offset;
+    if (length == 0) {
+      return;
+    }
+    auto const slack = static_cast<size_t>(offset % page_size());
+    auto const prot = mode_ == map_mode::read_only ? PROT_READ
+                                                   : PROT_READ | PROT_WRITE;
+    auto* p = ::mmap(nullptr,
+                     length + slack,
+                     prot,
+                     MAP_SHARED,
+                     fd_,
+                     static_cast<::off_t>(offset - slack));
+    if (p == MAP_FAILED) {
+      ec.assign(errno, std::system_category());
+      return;
+    }
+    base_ = static_cast<std::byte*>(p);
+    mapped_ = length + slack;
+    data_ = base_ + slack;  // NOLINT(*-pro-bounds-pointer-arithmetic)
+    size_ = length;
+  }
+
+  void unmap() noexcept {
+    if (mapped_ != 0) {
+      ::munmap(base_, mapped_);
+    }
+    base_ = nullptr;
+    mapped_ = 0;
+    data_ = nullptr;
+    size_ = 0;
+    offset_ = 0;
+  }
+
+  int fd_ = -1;
+  map_mode mode_ = map_mode::read_only;
+  std::uint64_t file_size_ = 0;
+  std::uint64_t offset_ = 0;
+  std::byte* base_ = nullptr;  // page-aligned start of the mapping
+  size_t mapped_ = 0;
+  std::byte* data_ = nullptr;  // first byte at offset_
+  size_t size_ = 0;
+};
+
+}  // namespace range3
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <system_error>
+#include <thread>
+
+#include "byte_span/byte_span.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RANGE3_BYTE_SPAN_MIRRORED_RING 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace range3 {
+
+// How a ring buffer lays out its storage. A plain ring hands out regions
+// that wrap around its end as two spans. A mirrored ring maps the same
+// physical pages twice, back to back, so every region is one contiguous
+// span; it needs POSIX shared memory and a page-multiple capacity.
+enum class ring_mode : unsigned char { plain, mirrored };
+
+// Up to two spans covering one region of a ring buffer: `second` is only
+// non-empty when the region wraps around the end of a plain ring.
+template <typename B>
+struct ring_segments {
+  byte_span<B> first;
+  byte_span<B> second;
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_t {
+    return first.size() + second.size();
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool {
+    return first.empty() && second.empty();
+  }
+};
+
+namespace detail {
+
+// Keeps indices written by different threads on different cache lines.
+inline constexpr size_t ring_cache_line = 64;
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// Power-of-two byte storage, plain or mirrored.
+class ring_storage {
+ public:
+  ring_storage() noexcept = default;
+
+  void allocate(size_t capacity, ring_mode mode, std::error_code& ec) noexcept {
+    ec.clear();
+    mode_ = mode;
+    if (capacity == 0 || capacity > std::numeric_limits<size_t>::max() / 4) {
+      ec = std::make_error_code(std::errc::invalid_argument);
+      return;
+    }
+    capacity = std::bit_ceil(capacity);
+    if (mode == ring_mode::plain) {
+      data_ = static_cast<std::byte*>(::operator new(
+          capacity, std::align_val_t{ring_cache_line}, std::nothrow));
+      if (data_ == nullptr) {
+        ec = std::make_error_code(std::errc::not_enough_memory);
+        return;
+      }
+    } else {
+      map_mirrored(capacity, ec);
+      if (ec) {
+        return;
+      }
+    }
+    capacity_ = capacity;
+  }
+
+  ring_storage(const ring_storage&) = delete;
+  auto operator=(const ring_storage&) -> ring_storage& = delete;
+  ring_storage(ring_storage&&) = delete;
+  auto operator=(ring_storage&&) -> ring_storage& = delete;
+
+  ~ring_storage() {
+    if (data_ == nullptr) {
+      return;
+    }
+    if (mode_ == ring_mode::plain) {
+      ::operator delete(data_, std::align_val_t{ring_cache_line});
+    } else {
+#if defined(RANGE3_BYTE_SPAN_MIRRORED_RING)
+      ::munmap(data_, 2 * capacity_);
+#endif
+    }
+  }
+
+  [[nodiscard]]
+  auto capacity() const noexcept -> size_t {
+    return capacity_;
+  }
+
+  [[nodiscard]]
+  auto mode() const noexcept -> ring_mode {
+    return mode_;
+  }
+
+  // The `count` bytes starting at stream position `pos`
+  template <typename B>
+  [[nodiscard]]
+  auto region(std::uint64_t pos, size_t count) const noexcept
+      -> ring_segments<B> {
+    auto const offset = static_cast<size_t>(pos) & (capacity_ - 1);
+    auto* const p = data_ + offset;
+    if (mode_ == ring_mode::mirrored) {
+      return {byte_span<B>{p, count}, {}};
+    }
+    auto const head = std::min(count, capacity_ - offset);
+    return {byte_span<B>{p, head}, byte_span<B>{data_, count - head}};
+  }
+
+ private:
+  void map_mirrored(size_t& capacity, std::error_code& ec) noexcept {
+#if defined(RANGE3_BYTE_SPAN_MIRRORED_RING)
+    auto const page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    capacity = std::max(capacity, page);
+#if defined(__linux__)
+    int const fd = ::memfd_create("range3_ring_buffer", MFD_CLOEXEC);
+#else
+    char path[] = "/tmp/range3_ring_buffer_XXXXXX";
+    int const fd = ::mkstemp(path);
+    if (fd != -1) {
+      ::unlink(path);
+    }
+#endif
+    if (fd == -1) {
+      ec.assign(errno, std::system_category());
+      return;
+    }
+    auto const fail = [&](void* reserved) noexcept {
+      ec.assign(errno, std::system_category());
+      if (reserved != MAP_FAILED) {
+        ::munmap(reserved, 2 * capacity);
+      }
+      ::close(fd);
+    };
+    if (::ftruncate(fd, static_cast<::off_t>(capacity)) != 0) {
+      fail(MAP_FAILED);
+      return;
+    }
+    // Reserve twice the address space, then map the file over both halves.
+    auto* const base = ::mmap(nullptr,
+                              2 * capacity,
+                              PROT_NONE,
+                              MAP_PRIVATE | MAP_ANONYMOUS,
+                              -1,
+                              0);
+    if (base == MAP_FAILED) {
+      fail(MAP_FAILED);
+      return;
+    }
+    auto* const bytes = static_cast<std::byte*>(base);
+    for (auto* const half : {bytes, bytes + capacity}) {
+      if (::mmap(half,
+                 capacity,
+                 PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_FIXED,
+                 fd,
+                 0)
+          == MAP_FAILED) {
+        fail(base);
+        return;
+      }
+    }
+    ::close(fd);
+    data_ = bytes;
+#else
+    (void)capacity;
+    ec = std::make_error_code(std::errc::not_supported);
+#endif
+  }
+
+  std::byte* data_ = nullptr;
+  size_t capacity_ = 0;
+  ring_mode mode_ = ring_mode::plain;
+};
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// Storage and the single consumer shared by both ring buffers. Positions
+// count bytes since construction and never wrap in practice (64 bits).
+class ring_consumer {
+ public:
+  [[nodiscard]]
+  auto capacity() const noexcept -> size_t {
+    return storage_.capacity();
+  }
+
+  [[nodiscard]]
+  auto mode() const noexcept -> ring_mode {
+    return storage_.mode();
+  }
+
+  // Bytes committed but not yet released; only a snapshot when other
+  // threads are active. The tail is loaded first: the head it is compared
+  // with can only be newer, so the difference never wraps. Both may move in
+  // between, so it is capped at the capacity.
+  [[nodiscard]]
+  auto size() const noexcept -> size_t {
+    auto const tail = tail_.load(std::memory_order_acquire);
+    auto const head = head_.load(std::memory_order_acquire);
+    return std::min(static_cast<size_t>(head - tail), capacity());
+  }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool {
+    return size() == 0;
+  }
+
+  // Consumer: up to `max` committed bytes, oldest first.
+  [[nodiscard]]
+  auto peek(size_t max = static_cast<size_t>(-1)) noexcept
+      -> ring_segments<const std::byte> {
+    auto const tail = tail_.load(std::memory_order_relaxed);
+    if (cached_head_ - tail < max) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    auto const n = std::min(static_cast<size_t>(cached_head_ - tail), max);
+    return storage_.region<const std::byte>(tail, n);
+  }
+
+  // Consumer: frees the oldest `count` bytes for the producers.
+  void release(size_t count) noexcept {
+    auto const tail = tail_.load(std::memory_order_relaxed);
+    assert(count <= cached_head_ - tail);
+    tail_.store(tail + count, std::memory_order_release);
+  }
+
+  // Consumer: copies up to out.size() bytes out and releases them.
+  auto read(byte_view out) noexcept -> size_t {
+    auto const r = peek(out.size());
+    std::ranges::copy(r.first, out.begin());
+    std::ranges::copy(r.second, out.subspan(r.first.size()).begin());
+    release(r.size());
+    return r.size();
+  }
+
+ protected:
+  ring_consumer(size_t capacity, ring_mode mode, std::error_code& ec) noexcept {
+    storage_.allocate(capacity, mode, ec);
+  }
+
+  ring_consumer(size_t capacity, ring_mode mode, const char* what) {
+    std::error_code ec;
+    storage_.allocate(capacity, mode, ec);
+    if (ec) {
+      throw std::system_error{ec, what};
+    }
+  }
+
+  ring_storage storage_;
+
+  // Written by the producer side, read by the consumer
+  alignas(ring_cache_line) std::atomic<std::uint64_t> head_{0};
+  std::uint64_t cached_tail_ = 0;  // producer's last view of tail_
+
+  // Written by the consumer, read by the producer side
+  alignas(ring_cache_line) std::atomic<std::uint64_t> tail_{0};
+  std::uint64_t cached_head_ = 0;  // consumer's last view of head_
+};
+
+inline void copy_into(ring_segments<std::byte> r, cbyte_view bytes) noexcept {
+  std::ranges::copy(bytes.first(r.first.size()), r.first.begin());
+  std::ranges::copy(bytes.subspan(r.first.size(), r.second.size()),
+                    r.second.begin());
+}
+
+}  // namespace detail
+
+// A lock-free byte ring for one producer thread and one consumer thread.
+//
+// The producer reserve()s space, fills the returned spans and commit()s the
+// bytes it wrote; the consumer peek()s at committed bytes and release()s
+// those it is done with. Nothing is copied through the ring itself, and each
+// side only touches the other's index when its cached copy runs out.
+// Capacity is rounded up to a power of two. Errors are reported
+// std::filesystem style.
+class spsc_ring_buffer : public detail::ring_consumer {
+ public:
+  explicit spsc_ring_buffer(size_t capacity,
+                            ring_mode mode = ring_mode::plain)
+      : ring_consumer{capacity, mode, "spsc_ring_buffer"} {}
+
+  spsc_ring_buffer(size_t capacity,
+                   ring_mode mode,
+                   std::error_code& ec) noexcept
+      : ring_consumer{capacity, mode, ec} {}
+
+  // Producer: up to `max` bytes of free space.
+  [[nodiscard]]
+  auto reserve(size_t max) noexcept -> ring_segments<std::byte> {
+    auto const head = head_.load(std::memory_order_relaxed);
+    if (free_space(head) < max) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    auto const n = std::min(max, free_space(head));
+    return storage_.region<std::byte>(head, n);
+  }
+
+  // Producer: publishes the first `count` reserved bytes.
+  void commit(size_t count) noexcept {
+    auto const head = head_.load(std::memory_order_relaxed);
+    assert(count <= free_space(head));
+    head_.store(head + count, std::memory_order_release);
+  }
+
+  // Producer: copies as much of `bytes` as fits and commits it.
+  auto write(cbyte_view bytes) noexcept -> size_t {
+    auto const r = reserve(bytes.size());
+    detail::copy_into(r, bytes);
+    commit(r.size());
+    return r.size();
+  }
+
+ private:
+  [[nodiscard]]
+  auto free_space(std::uint64_t head) const noexcept -> size_t {
+    return capacity() - static_cast<size_t>(head - cached_tail_);
+  }
+};
+
+// A byte ring for any number of producer threads and one consumer thread.
+//
+// Producers claim space with a compare-and-swap, so reserving never blocks.
+// Claims are published in the order they were made: commit() waits until
+// every earlier claim has been committed, so a reservation should be filled
+// and committed promptly. The consumer side is the same as spsc_ring_buffer.
+class mpsc_ring_buffer : public detail::ring_consumer {
+ public:
+  // Free space claimed by one producer. An empty reservation need not be
+  // committed.
+  class reservation : public ring_segments<std::byte> {
+   public:
+    reservation() noexcept = default;
+
+   private:
+    friend class mpsc_ring_buffer;
+
+    reservation(ring_segments<std::byte> bytes, std::uint64_t pos) noexcept
+        : ring_segments<std::byte>{bytes}, position_{pos} {}
+
+    std::uint64_t position_ = 0;
+  };
+
+  explicit mpsc_ring_buffer(size_t capacity,
+                            ring_mode mode = ring_mode::plain)
+      : ring_consumer{capacity, mode, "mpsc_ring_buffer"} {}
+
+  mpsc_ring_buffer(size_t capacity,
+                   ring_mode mode,
+                   std::error_code& ec) noexcept
+      : ring_consumer{capacity, mode, ec} {}
+
+  // Producer: claims up to `max` bytes of free space.
+  [[nodiscard]]
+  auto reserve(size_t max) noexcept -> reservation {
+    auto pos = claim_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto const tail = tail_.load(std::memory_order_acquire);
+      // A stale `pos` may trail a tail that has moved past it.
+      if (pos < tail) {
+        pos = claim_.load(std::memory_order_relaxed);
+        continue;
+      }
+      auto const used = static_cast<size_t>(pos - tail);
+      auto const n = std::min(max, capacity() - used);
+      if (n == 0) {
+        return {};
+      }
+      if (claim_.compare_exchange_weak(
+              pos, pos + n, std::memory_order_relaxed)) {
+        return {storage_.region<std::byte>(pos, n), pos};
+      }
+    }
+  }
+
+  // Producer: publishes a whole reservation once all earlier ones are.
+  void commit(const reservation& r) noexcept {
+    if (r.empty()) {
+      return;
+    }
+    for (unsigned spins = 0;
+         head_.load(std::memory_order_acquire) != r.position_;
+         ++spins) {
+      if (spins >= 64) {
+        std::this_thread::yield();
+      }
+    }
+    head_.store(r.position_ + r.size(), std::memory_order_release);
+  }
+
+  // Producer: copies as much of `bytes` as fits and commits it.
+  auto write(cbyte_view bytes) noexcept -> size_t {
+    auto const r = reserve(bytes.size());
+    detail::copy_into(r, bytes);
+    commit(r);
+    return r.size();
+  }
+
+ private:
+  alignas(detail::ring_cache_line) std::atomic<std::uint64_t> claim_{0};
+};
+
+}  // namespace range3
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "byte_span/byte_span.hpp"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "byte_span/scatter_gather.hpp requires POSIX vectored I/O"
+#endif
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace range3 {
+
+// An iovec describing `bytes`. The kernel never writes through the iovecs
+// passed to writev, so const views are accepted.
+template <typename B, size_t N>
+[[nodiscard]]
+auto to_iovec(byte_span<B, N> bytes) noexcept -> ::iovec {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  return {const_cast<void*>(static_cast<const void*>(bytes.data())),
+          bytes.size()};
+}
+
+[[nodiscard]]
+inline auto from_iovec(const ::iovec& v) noexcept -> byte_view {
+  return byte_view{v.iov_base, v.iov_len};
+}
+
+// An ordered list of byte views held directly as iovecs, so it is passed to
+// readv/writev without conversion. Up to InlineCapacity views are stored in
+// place; more spill to the heap. consume() drops bytes from the front in
+// O(1) per fully consumed view, which is how partial transfers advance it.
+template <typename B, size_t InlineCapacity = 8>
+  requires std::same_as<std::remove_const_t<B>, std::byte>
+class byte_span_sequence {
+ public:
+  using value_type = byte_span<B>;
+
+  class iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = byte_span<B>;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+    explicit iterator(const ::iovec* v) noexcept : v_{v} {}
+
+    auto operator*() const noexcept -> value_type {
+      return value_type{v_->iov_base, v_->iov_len};
+    }
+    auto operator[](difference_type n) const noexcept -> value_type {
+      return *(*this + n);
+    }
+    auto operator++() noexcept -> iterator& {
+      ++v_;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return *this;
+    }
+    auto operator++(int) noexcept -> iterator {
+      auto const old = *this;
+      ++*this;
+      return old;
+    }
+    auto operator--() noexcept -> iterator& {
+      --v_;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return *this;
+    }
+    auto operator--(int) noexcept -> iterator {
+      auto const old = *this;
+      --*this;
+      return old;
+    }
+    auto operator+=(difference_type n) noexcept -> iterator& {
+      v_ += n;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return *this;
+    }
+    auto operator-=(difference_type n) noexcept -> iterator& {
+      v_ -= n;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return *this;
+    }
+    friend auto operator+(iterator it, difference_type n) noexcept
+        -> iterator {
+      return it += n;
+    }
+    friend auto operator+(difference_type n, iterator it) noexcept
+        -> iterator {
+      return it += n;
+    }
+    friend auto operator-(iterator it, difference_type n) noexcept
+        -> iterator {
+      return it -= n;
+    }
+    friend auto operator-(iterator a, iterator b) noexcept -> difference_type {
+      return a.v_ - b.v_;
+    }
+    friend auto operator==(iterator a, iterator b) noexcept -> bool = default;
+    friend auto operator<=>(iterator a, iterator b) noexcept = default;
+
+   private:
+    const ::iovec* v_ = nullptr;
+  };
+
+  byte_span_sequence() noexcept = default;
+
+  byte_span_sequence(std::initializer_list<value_type> views) {
+    for (auto const& v : views) {
+      push_back(v);
+    }
+  }
+
+  // Adopts the descriptors of `vecs`; the bytes they describe are not copied.
+  explicit byte_span_sequence(std::span<const ::iovec> vecs) {
+    for (auto const& v : vecs) {
+      push_back(value_type{v.iov_base, v.iov_len});
+    }
+  }
+
+  byte_span_sequence(const byte_span_sequence&) = default;
+  auto operator=(const byte_span_sequence&) -> byte_span_sequence& = default;
+
+  // The moved-from sequence is left empty.
+  byte_span_sequence(byte_span_sequence&& other) noexcept
+      : inline_{other.inline_},
+        heap_{std::move(other.heap_)},
+        first_{other.first_},
+        last_{other.last_},
+        total_{other.total_} {
+    other.heap_.clear();
+    other.clear();
+  }
+
+  auto operator=(byte_span_sequence&& other) noexcept -> byte_span_sequence& {
+    if (this != &other) {
+      inline_ = other.inline_;
+      heap_ = std::move(other.heap_);
+      first_ = other.first_;
+      last_ = other.last_;
+      total_ = other.total_;
+      other.heap_.clear();
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~byte_span_sequence() = default;
+
+  void push_back(value_type bytes) {
+    if (last_ == capacity()) {
+      grow();
+    }
+    storage()[last_++] = to_iovec(bytes);
+    total_ += bytes.size();
+  }
+
+  // Number of views
+  [[nodiscard]]
+  auto size() const noexcept -> size_t {
+    return last_ - first_;
+  }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool {
+    return first_ == last_;
+  }
+
+  // Number of bytes across all views
+  [[nodiscard]]
+  auto total_size() const noexcept -> size_t {
+    return total_;
+  }
+
+  [[nodiscard]]
+  auto operator[](size_t i) const noexcept -> value_type {
+    assert(i < size());
+    return begin()[static_cast<std::ptrdiff_t>(i)];
+  }
+
+  [[nodiscard]]
+  auto front() const noexcept -> value_type {
+    return (*this)[0];
+  }
+
+  [[nodiscard]]
+  auto begin() const noexcept -> iterator {
+    return iterator{iovecs().data()};
+  }
+
+  [[nodiscard]]
+  auto end() const noexcept -> iterator {
+    return begin() + static_cast<std::ptrdiff_t>(size());
+  }
+
+  [[nodiscard]]
+  auto iovecs() const noexcept -> std::span<const ::iovec> {
+    return std::span<const ::iovec>{storage(), last_}.subspan(first_);
+  }
+
+  // Drops `count` bytes from the front: whole views are removed and the
+  // first remaining one is narrowed with subspan.
+  void consume(size_t count) noexcept {
+    assert(count <= total_);
+    total_ -= count;
+    auto* v = storage();
+    while (count != 0) {
+      auto const head = value_type{v[first_].iov_base, v[first_].iov_len};
+      if (count < head.size()) {
+        v[first_] = to_iovec(head.subspan(count));
+        return;
+      }
+      count -= head.size();
+      ++first_;
+    }
+    while (first_ != last_ && v[first_].iov_len == 0) {
+      ++first_;
+    }
+  }
+
+  void clear() noexcept {
+    first_ = 0;
+    last_ = 0;
+    total_ = 0;
+  }
+
+ private:
+  [[nodiscard]]
+  auto capacity() const noexcept -> size_t {
+    return heap_.empty() ? InlineCapacity : heap_.size();
+  }
+
+  [[nodiscard]]
+  auto storage() const noexcept -> const ::iovec* {
+    return heap_.empty() ? inline_.data() : heap_.data();
+  }
+
+  [[nodiscard]]
+  auto storage() noexcept -> ::iovec* {
+    return heap_.empty() ? inline_.data() : heap_.data();
+  }
+
+  // Reclaims consumed slots first; only a full sequence reallocates.
+  void grow() {
+    auto const live = iovecs();
+    if (first_ != 0) {
+      std::ranges::copy(live, storage());
+    } else {
+      std::vector<::iovec> bigger(std::max<size_t>(2 * capacity(), 16));
+      std::ranges::copy(live, bigger.begin());
+      heap_ = std::move(bigger);
+    }
+    last_ = live.size();
+    first_ = 0;
+  }
+
+  std::array<::iovec, InlineCapacity> inline_{};
+  std::vector<::iovec> heap_;
+  size_t first_ = 0;
+  size_t last_ = 0;
+  size_t total_ = 0;
+};
+
+using io_buffers = byte_span_sequence<std::byte>;
+using const_io_buffers = byte_span_sequence<const std::byte>;
+
+namespace detail {
+
+// At most IOV_MAX iovecs go into one call; the rest wait for the next one.
+inline auto iov_count(std::span<const ::iovec> vecs) noexcept -> int {
+#if defined(IOV_MAX)
+  constexpr size_t limit = IOV_MAX;
+#else
+  constexpr size_t limit = 1024;
+#endif
+  return static_cast<int>(std::min(vecs.size(), limit));
+}
+
+// Runs a vectored call, retrying on EINTR, and advances `seq` past the bytes
+// transferred.
+template <typename Seq, typename Call>
+auto vectored(Seq& seq, std::error_code& ec, Call call) noexcept -> size_t {
+  ec.clear();
+  if (seq.empty()) {
+    return 0;
+  }
+  for (;;) {
+    auto const vecs = seq.iovecs();
+    auto const n = call(vecs.data(), iov_count(vecs));
+    if (n >= 0) {
+      seq.consume(static_cast<size_t>(n));
+      return static_cast<size_t>(n);
+    }
+    if (errno != EINTR) {
+      ec.assign(errno, std::system_category());
+      return 0;
+    }
+  }
+}
+
+}  // namespace detail
+
+// The vectored I/O helpers transfer as much as one system call does, consume
+// the transferred bytes from `seq` and return their count. Errors are
+// reported through `ec`; EINTR is retried.
+
+template <size_t N>
+auto readv(int fd,
+           byte_span_sequence<std::byte, N>& seq,
+           std::error_code& ec) noexcept -> size_t {
+  return detail::vectored(seq, ec, [fd](const ::iovec* v, int count) {
+    return ::readv(fd, v, count);
+  });
+}
+
+template <size_t N>
+auto writev(int fd,
+            byte_span_sequence<const std::byte, N>& seq,
+            std::error_code& ec) noexcept -> size_t {
+  return detail::vectored(seq, ec, [fd](const ::iovec* v, int count) {
+    return ::writev(fd, v, count);
+  });
+}
+
+// Repeats writev until `seq` is empty or an error occurs.
+template <size_t N>
+auto write_all(int fd,
+               byte_span_sequence<const std::byte, N>& seq,
+               std::error_code& ec) noexcept -> size_t {
+  size_t total = 0;
+  while (!seq.empty()) {
+    total += writev(fd, seq, ec);
+    if (ec) {
+      break;
+    }
+  }
+  return total;
+}
+
+template <size_t N>
+auto preadv(int fd,
+            byte_span_sequence<std::byte, N>& seq,
+            std::uint64_t offset,
+            std::error_code& ec) noexcept -> size_t {
+  return detail::vectored(seq, ec, [=](const ::iovec* v, int count) {
+    return ::preadv(fd, v, count, static_cast<::off_t>(offset));
+  });
+}
+
+template <size_t N>
+auto pwritev(int fd,
+             byte_span_sequence<const std::byte, N>& seq,
+             std::uint64_t offset,
+             std::error_code& ec) noexcept -> size_t {
+  return detail::vectored(seq, ec, [=](const ::iovec* v, int count) {
+    return ::pwritev(fd, v, count, static_cast<::off_t>(offset));
+  });
+}
+
+#if defined(__linux__) && defined(RWF_NOWAIT)
+
+// Linux variants taking RWF_* flags, e.g. RWF_NOWAIT or RWF_DSYNC. An offset
+// of -1 uses and updates the file position.
+template <size_t N>
+auto preadv2(int fd,
+             byte_span_sequence<std::byte, N>& seq,
+             std::int64_t offset,
+             int flags,
+             std::error_code& ec) noexcept -> size_t {
+  return detail::vectored(seq, ec, [=](const ::iovec* v, int count) {
+    return ::preadv2(fd, v, count, static_cast<::off_t>(offset), flags);
+  });
+}
+
+template <size_t N>
+auto pwritev2(int fd,
+              byte_span_sequence<const std::byte, N>& seq,
+              std::int64_t offset,
+              int flags,
+              std::error_code& ec) noexcept -> size_t {
+  return detail::vectored(seq, ec, [=](const ::iovec* v, int count) {
+    return ::pwritev2(fd, v, count, static_cast<::off_t>(offset), flags);
+  });
+}
+
+#endif
+
+}  // namespace range3
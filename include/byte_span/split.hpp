@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/find.hpp"
+
+namespace range3 {
+
+// Whether tokens include the delimiter that ends them.
+enum class split_mode {
+  drop_delimiter,
+  keep_delimiter,
+};
+
+namespace detail {
+
+// Delimiter policies: find() returns the offset of the next delimiter at or
+// after `pos` (or npos) through the vectorized kernels of find.hpp, and
+// size() its length.
+
+struct byte_delimiter {
+  std::byte value;
+
+  [[nodiscard]]
+  constexpr auto find(cbyte_view bytes, size_t pos) const noexcept -> size_t {
+    return find_if(bytes, pos, byte_equal{value});
+  }
+
+  [[nodiscard]]
+  static constexpr auto size() noexcept -> size_t {
+    return 1;
+  }
+};
+
+struct set_delimiter {
+  byte_set set;
+
+  [[nodiscard]]
+  constexpr auto find(cbyte_view bytes, size_t pos) const noexcept -> size_t {
+    return find_in_set(bytes, pos, set, set.vectorizable());
+  }
+
+  [[nodiscard]]
+  static constexpr auto size() noexcept -> size_t {
+    return 1;
+  }
+};
+
+struct sequence_delimiter {
+  cbyte_view separator;
+
+  [[nodiscard]]
+  constexpr auto find(cbyte_view bytes, size_t pos) const noexcept -> size_t {
+    return find_sequence(bytes, separator, pos);
+  }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_t {
+    return separator.size();
+  }
+};
+
+}  // namespace detail
+
+// Lazily splits a byte view into cbyte_view tokens at each delimiter.
+//
+// With split_mode::drop_delimiter, N delimiters yield N + 1 tokens, empty ones
+// included, as std::views::split does; an empty input yields none. With
+// split_mode::keep_delimiter each token ends with its delimiter, so the tokens
+// concatenate back to the input and a delimiter at the very end does not start
+// another, empty, token.
+//
+// Iterators carry the bytes and the delimiter themselves, so tokens and
+// iterators stay valid after the view is gone. Like cbyte_view itself, the
+// view does not own the separator or set bytes it was given.
+template <typename Delimiter>
+class split_view : public std::ranges::view_interface<split_view<Delimiter>> {
+ public:
+  class iterator {
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = cbyte_view;
+    using difference_type = std::ptrdiff_t;
+    using reference = cbyte_view;
+
+    constexpr iterator() noexcept = default;
+
+    [[nodiscard]]
+    constexpr auto operator*() const noexcept -> cbyte_view {
+      return token_;
+    }
+
+    constexpr auto operator++() noexcept -> iterator& {
+      if (next_ == npos) {
+        token_ = {};
+        done_ = true;
+      } else {
+        advance(next_);
+      }
+      return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> iterator {
+      auto const old = *this;
+      ++*this;
+      return old;
+    }
+
+    friend constexpr auto operator==(const iterator& a,
+                                     const iterator& b) noexcept -> bool {
+      return a.done_ == b.done_ && a.token_.data() == b.token_.data();
+    }
+
+    friend constexpr auto operator==(const iterator& it,
+                                     std::default_sentinel_t /*end*/) noexcept
+        -> bool {
+      return it.done_;
+    }
+
+   private:
+    friend class split_view;
+
+    constexpr iterator(cbyte_view bytes,
+                       const Delimiter& delimiter,
+                       split_mode mode) noexcept
+        : bytes_{bytes},
+          delimiter_{delimiter},
+          mode_{mode},
+          done_{bytes.empty()} {
+      if (!done_) {
+        advance(0);
+      }
+    }
+
+    // Makes the token starting at `pos` current.
+    constexpr void advance(size_t pos) noexcept {
+      auto const at = delimiter_.find(bytes_, pos);
+      if (at == npos) {
+        token_ = bytes_.subspan(pos);
+        next_ = npos;
+        return;
+      }
+      auto const end = at + delimiter_.size();
+      if (mode_ == split_mode::keep_delimiter) {
+        token_ = bytes_.subspan(pos, end - pos);
+        next_ = end == bytes_.size() ? npos : end;
+      } else {
+        token_ = bytes_.subspan(pos, at - pos);
+        next_ = end;
+      }
+    }
+
+    cbyte_view bytes_;
+    cbyte_view token_;
+    size_t next_ = npos;
+    Delimiter delimiter_{};
+    split_mode mode_ = split_mode::drop_delimiter;
+    bool done_ = true;
+  };
+
+  constexpr split_view() noexcept = default;
+
+  constexpr split_view(cbyte_view bytes,
+                       Delimiter delimiter,
+                       split_mode mode) noexcept
+      : bytes_{bytes}, delimiter_{delimiter}, mode_{mode} {}
+
+  // Searches for the first delimiter on every call.
+  [[nodiscard]]
+  constexpr auto begin() const noexcept -> iterator {
+    return iterator{bytes_, delimiter_, mode_};
+  }
+
+  [[nodiscard]]
+  static constexpr auto end() noexcept -> std::default_sentinel_t {
+    return std::default_sentinel;
+  }
+
+  [[nodiscard]]
+  constexpr auto base() const noexcept -> cbyte_view {
+    return bytes_;
+  }
+
+ private:
+  cbyte_view bytes_;
+  Delimiter delimiter_{};
+  split_mode mode_ = split_mode::drop_delimiter;
+};
+
+// Tokens separated by the byte `delimiter`
+[[nodiscard]]
+constexpr auto split(cbyte_view bytes,
+                     std::byte delimiter,
+                     split_mode mode = split_mode::drop_delimiter) noexcept
+    -> split_view<detail::byte_delimiter> {
+  return {bytes, detail::byte_delimiter{delimiter}, mode};
+}
+
+// Tokens separated by the non-empty byte sequence `separator`
+[[nodiscard]]
+constexpr auto split(cbyte_view bytes,
+                     cbyte_view separator,
+                     split_mode mode = split_mode::drop_delimiter) noexcept
+    -> split_view<detail::sequence_delimiter> {
+  assert(!separator.empty());
+  return {bytes, detail::sequence_delimiter{separator}, mode};
+}
+
+// Tokens separated by any single byte contained in `set`
+[[nodiscard]]
+constexpr auto split_any(cbyte_view bytes,
+                         cbyte_view set,
+                         split_mode mode = split_mode::drop_delimiter) noexcept
+    -> split_view<detail::set_delimiter> {
+  return {bytes,
+          detail::set_delimiter{detail::byte_set{set.data(), set.size()}},
+          mode};
+}
+
+}  // namespace range3
+
+template <typename D>
+constexpr bool std::ranges::enable_borrowed_range<range3::split_view<D>> = true;
+
+template <typename D>
+constexpr bool std::ranges::enable_view<range3::split_view<D>> = true;
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/bit.hpp"
+
+namespace range3 {
+
+namespace detail {
+
+template <typename T>
+concept unaligned_value =
+    std::is_trivially_copyable_v<T> && !std::is_array_v<T>
+    && !std::is_const_v<T> && !std::is_volatile_v<T>;
+
+// Proxy for one element of a writable unaligned_span: reads and writes go
+// through memcpy.
+template <typename T>
+class unaligned_ref {
+ public:
+  constexpr explicit unaligned_ref(std::byte* p) noexcept : p_{p} {}
+  constexpr unaligned_ref(const unaligned_ref&) noexcept = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr operator T() const noexcept { return load_value<T>(p_); }
+
+  // Assignment stores through the proxy, so it is const like a pointer.
+  // NOLINTBEGIN(misc-unconventional-assign-operator)
+  constexpr auto operator=(const T& value) const noexcept
+      -> const unaligned_ref& {
+    store_value(p_, value);
+    return *this;
+  }
+
+  constexpr auto operator=(const unaligned_ref& other) const noexcept
+      -> const unaligned_ref& {
+    return *this = static_cast<T>(other);
+  }
+  // NOLINTEND(misc-unconventional-assign-operator)
+
+ private:
+  std::byte* p_;
+};
+
+}  // namespace detail
+
+// Copies a T out of `sizeof(T)` bytes at `offset`. No alignment is required,
+// and unlike as_value no T object has to live there, so this is the way to
+// read structs and numbers out of network or file buffers.
+template <detail::unaligned_value T>
+[[nodiscard]]
+constexpr auto load(cbyte_view bytes, size_t offset = 0) noexcept -> T {
+  assert(offset <= bytes.size() && bytes.size() - offset >= sizeof(T));
+  return detail::load_value<T>(bytes.data() + offset);
+}
+
+template <detail::unaligned_value T>
+constexpr void store(byte_view bytes,
+                     const T& value,
+                     size_t offset = 0) noexcept {
+  assert(offset <= bytes.size() && bytes.size() - offset >= sizeof(T));
+  detail::store_value(bytes.data() + offset, value);
+}
+
+// Copies the whole T elements at the front of `bytes` into `out`, as many as
+// fit, and returns their count. One memcpy moves the lot.
+template <detail::unaligned_value T>
+constexpr auto copy_as(cbyte_view bytes, std::span<T> out) noexcept
+    -> size_t {
+  auto const count = std::min(bytes.size() / sizeof(T), out.size());
+  if (std::is_constant_evaluated()) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = detail::load_value<T>(bytes.data() + (i * sizeof(T)));
+    }
+  } else if (count != 0) {
+    std::memcpy(out.data(), bytes.data(), count * sizeof(T));
+  }
+  return count;
+}
+
+// A span of T stored at arbitrary alignment: element access copies through
+// memcpy instead of dereferencing a T*, which as_span requires to be
+// aligned. unaligned_span<const T> reads from a cbyte_view and yields T by
+// value; unaligned_span<T> writes to a byte_view through a proxy reference.
+template <typename T>
+  requires detail::unaligned_value<std::remove_const_t<T>>
+class unaligned_span {
+  using byte_type =
+      std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>;
+
+ public:
+  using element_type = T;
+  using value_type = std::remove_const_t<T>;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<std::is_const_v<T>,
+                                       value_type,
+                                       detail::unaligned_ref<value_type>>;
+
+  class iterator {
+   public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = unaligned_span::reference;
+
+    constexpr iterator() noexcept = default;
+    constexpr explicit iterator(byte_type* p) noexcept : p_{p} {}
+
+    constexpr auto operator*() const noexcept -> reference {
+      if constexpr (std::is_const_v<T>) {
+        return detail::load_value<value_type>(p_);
+      } else {
+        return reference{p_};
+      }
+    }
+    constexpr auto operator[](difference_type n) const noexcept -> reference {
+      return *(*this + n);
+    }
+    constexpr auto operator++() noexcept -> iterator& {
+      return *this += 1;
+    }
+    constexpr auto operator++(int) noexcept -> iterator {
+      auto const old = *this;
+      ++*this;
+      return old;
+    }
+    constexpr auto operator--() noexcept -> iterator& {
+      return *this -= 1;
+    }
+    constexpr auto operator--(int) noexcept -> iterator {
+      auto const old = *this;
+      --*this;
+      return old;
+    }
+    constexpr auto operator+=(difference_type n) noexcept -> iterator& {
+      p_ += n * stride;
+      return *this;
+    }
+    constexpr auto operator-=(difference_type n) noexcept -> iterator& {
+      p_ -= n * stride;
+      return *this;
+    }
+    friend constexpr auto operator+(iterator it, difference_type n) noexcept
+        -> iterator {
+      return it += n;
+    }
+    friend constexpr auto operator+(difference_type n, iterator it) noexcept
+        -> iterator {
+      return it += n;
+    }
+    friend constexpr auto operator-(iterator it, difference_type n) noexcept
+        -> iterator {
+      return it -= n;
+    }
+    friend constexpr auto operator-(iterator a, iterator b) noexcept
+        -> difference_type {
+      return (a.p_ - b.p_) / stride;
+    }
+    friend constexpr auto operator==(iterator a, iterator b) noexcept
+        -> bool = default;
+    friend constexpr auto operator<=>(iterator a, iterator b) noexcept =
+        default;
+
+   private:
+    static constexpr auto stride = static_cast<difference_type>(sizeof(T));
+
+    byte_type* p_ = nullptr;
+  };
+
+  constexpr unaligned_span() noexcept = default;
+
+  // `bytes` must hold a whole number of elements.
+  constexpr explicit unaligned_span(byte_span<byte_type> bytes) noexcept
+      : data_{bytes.data()}, size_{bytes.size() / sizeof(T)} {
+    assert(bytes.size() % sizeof(T) == 0);
+  }
+
+  // unaligned_span<T> -> unaligned_span<const T>
+  template <typename U>
+    requires std::is_const_v<T> && std::same_as<U, value_type>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr unaligned_span(unaligned_span<U> other) noexcept
+      : data_{other.bytes().data()}, size_{other.size()} {}
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_t {
+    return size_;
+  }
+
+  [[nodiscard]]
+  constexpr auto size_bytes() const noexcept -> size_t {
+    return size_ * sizeof(T);
+  }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool {
+    return size_ == 0;
+  }
+
+  [[nodiscard]]
+  constexpr auto bytes() const noexcept -> byte_span<byte_type> {
+    return byte_span<byte_type>{data_, size_bytes()};
+  }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_t i) const noexcept -> reference {
+    assert(i < size_);
+    return begin()[static_cast<difference_type>(i)];
+  }
+
+  [[nodiscard]]
+  constexpr auto front() const noexcept -> reference {
+    return (*this)[0];
+  }
+
+  [[nodiscard]]
+  constexpr auto back() const noexcept -> reference {
+    return (*this)[size_ - 1];
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() const noexcept -> iterator {
+    return iterator{data_};
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept -> iterator {
+    return begin() + static_cast<difference_type>(size_);
+  }
+
+  // Sub-views count elements, not bytes.
+  [[nodiscard]]
+  constexpr auto first(size_t count) const noexcept -> unaligned_span {
+    return subspan(0, count);
+  }
+
+  [[nodiscard]]
+  constexpr auto last(size_t count) const noexcept -> unaligned_span {
+    assert(count <= size_);
+    return subspan(size_ - count, count);
+  }
+
+  [[nodiscard]]
+  constexpr auto subspan(size_t offset,
+                         size_t count = dynamic_extent) const noexcept
+      -> unaligned_span {
+    assert(offset <= size_);
+    count = count == dynamic_extent ? size_ - offset : count;
+    assert(count <= size_ - offset);
+    return unaligned_span{bytes().subspan(offset * sizeof(T),
+                                          count * sizeof(T))};
+  }
+
+ private:
+  byte_type* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+template <typename T>
+unaligned_span(unaligned_span<T>) -> unaligned_span<T>;
+
+}  // namespace range3
+
+template <typename T>
+constexpr bool std::ranges::enable_borrowed_range<range3::unaligned_span<T>> =
+    true;
+
+template <typename T>
+constexpr bool std::ranges::enable_view<range3::unaligned_span<T>> = true;
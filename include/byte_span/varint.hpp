@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/detail/bit.hpp"
+#include "byte_span/detail/simd.hpp"
+#include "byte_span/error.hpp"
+
+#if !defined(RANGE3_BYTE_SPAN_NO_SIMD) && defined(__BMI2__) \
+    && (defined(__x86_64__) || defined(_M_X64))
+#define RANGE3_BYTE_SPAN_VARINT_BMI2 1
+#include <immintrin.h>
+#endif
+
+namespace range3 {
+
+namespace detail {
+
+// Integers of up to 64 bits. Signed types are zigzag-encoded.
+template <typename T>
+concept varint_value = std::integral<T>
+                    && !std::same_as<std::remove_cv_t<T>, bool>
+                    && sizeof(T) <= sizeof(std::uint64_t);
+
+}  // namespace detail
+
+// Longest LEB128 encoding of a T.
+template <detail::varint_value T>
+inline constexpr size_t max_varint_size =
+    (std::numeric_limits<std::make_unsigned_t<std::remove_cv_t<T>>>::digits + 6)
+    / 7;
+
+// Maps signed integers to unsigned ones so that values of small magnitude
+// have short encodings: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+template <std::signed_integral T>
+[[nodiscard]]
+constexpr auto zigzag_encode(T value) noexcept -> std::make_unsigned_t<T> {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<U>(
+      static_cast<U>(static_cast<U>(value) << 1U)
+      ^ static_cast<U>(value >> std::numeric_limits<T>::digits));
+}
+
+template <std::unsigned_integral T>
+[[nodiscard]]
+constexpr auto zigzag_decode(T value) noexcept -> std::make_signed_t<T> {
+  auto const sign = static_cast<T>(-static_cast<T>(value & 1U));
+  return static_cast<std::make_signed_t<T>>(static_cast<T>(value >> 1U) ^ sign);
+}
+
+template <typename T>
+struct varint_result {
+  T value{};
+  size_t size{};  // bytes consumed
+  byte_errc ec{};
+
+  constexpr explicit operator bool() const noexcept {
+    return ec == byte_errc{};
+  }
+};
+
+struct varint_batch_result {
+  size_t count{};  // values decoded or encoded
+  size_t size{};   // bytes consumed or written
+  byte_errc ec{};
+
+  constexpr explicit operator bool() const noexcept {
+    return ec == byte_errc{};
+  }
+};
+
+namespace detail {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+template <varint_value T>
+constexpr auto to_varint_bits(T value) noexcept -> std::uint64_t {
+  if constexpr (std::is_signed_v<T>) {
+    return zigzag_encode(value);
+  } else {
+    return value;
+  }
+}
+
+template <varint_value T>
+constexpr auto from_varint_bits(std::uint64_t bits) noexcept -> T {
+  using U = std::make_unsigned_t<T>;
+  if constexpr (std::is_signed_v<T>) {
+    return zigzag_decode(static_cast<U>(bits));
+  } else {
+    return static_cast<U>(bits);
+  }
+}
+
+constexpr auto varint_size_of(std::uint64_t bits) noexcept -> size_t {
+  return (static_cast<size_t>(std::bit_width(bits | 1U)) + 6) / 7;
+}
+
+// Gathers the low 7 bits of each of the eight bytes into 56 bits.
+constexpr auto varint_compact(std::uint64_t x) noexcept -> std::uint64_t {
+#if defined(RANGE3_BYTE_SPAN_VARINT_BMI2)
+  if (!std::is_constant_evaluated()) {
+    return _pext_u64(x, 0x7F7F7F7F7F7F7F7FU);
+  }
+#endif
+  x = ((x & 0x7F007F007F007F00U) >> 1U) | (x & 0x007F007F007F007FU);
+  x = ((x & 0x3FFF00003FFF0000U) >> 2U) | (x & 0x00003FFF00003FFFU);
+  return ((x & 0x0FFFFFFF00000000U) >> 4U) | (x & 0x000000000FFFFFFFU);
+}
+
+// Inverse of varint_compact for values below 2^56.
+constexpr auto varint_spread(std::uint64_t x) noexcept -> std::uint64_t {
+#if defined(RANGE3_BYTE_SPAN_VARINT_BMI2)
+  if (!std::is_constant_evaluated()) {
+    return _pdep_u64(x, 0x7F7F7F7F7F7F7F7FU);
+  }
+#endif
+  x = ((x & 0x00FFFFFFF0000000U) << 4U) | (x & 0x000000000FFFFFFFU);
+  x = ((x & 0x0FFFC0000FFFC000U) << 2U) | (x & 0x00003FFF00003FFFU);
+  return ((x & 0x3F803F803F803F80U) << 1U) | (x & 0x007F007F007F007FU);
+}
+
+// Reference decoder: one byte at a time, never reads past `n`.
+template <std::unsigned_integral U>
+constexpr auto decode_varint_scalar(const std::byte* p, size_t n) noexcept
+    -> varint_result<U> {
+  constexpr auto max_size = max_varint_size<U>;
+  constexpr auto digits = std::numeric_limits<U>::digits;
+  std::uint64_t bits = 0;
+  auto const limit = std::min(n, max_size);
+  for (size_t i = 0; i < limit; ++i) {
+    auto const b = std::to_integer<std::uint64_t>(p[i]);
+    bits |= (b & 0x7FU) << (7 * i);
+    if ((b & 0x80U) == 0) {
+      if (i + 1 == max_size && ((b & 0x7FU) >> (digits - (7 * i))) != 0) {
+        return {.ec = byte_errc::invalid_encoding};
+      }
+      return {static_cast<U>(bits), i + 1, {}};
+    }
+  }
+  return {.ec = n >= max_size ? byte_errc::invalid_encoding
+                              : byte_errc::out_of_range};
+}
+
+// Decodes the `len`-byte varint at `p` whose terminator is already known.
+// Reads eight bytes from `p` regardless of `len`.
+template <std::unsigned_integral U>
+inline auto decode_varint_known(const std::byte* p,
+                                size_t len,
+                                U& out) noexcept -> bool {
+  if (len > max_varint_size<U>) {
+    return false;
+  }
+  auto word = read_le<std::uint64_t>(p);
+  if (len < 8) {
+    word &= (std::uint64_t{1} << (8 * len)) - 1;
+  }
+  auto bits = varint_compact(word);
+  if constexpr (sizeof(U) == sizeof(std::uint64_t)) {
+    if (len > 8) {
+      bits |= (std::to_integer<std::uint64_t>(p[8]) & 0x7FU) << 56U;
+      if (len == 10) {
+        auto const last = std::to_integer<std::uint64_t>(p[9]);
+        if (last > 1) {
+          return false;
+        }
+        bits |= last << 63U;
+      }
+    }
+  } else {
+    if ((bits >> std::numeric_limits<U>::digits) != 0) {
+      return false;
+    }
+  }
+  out = static_cast<U>(bits);
+  return true;
+}
+
+struct varint_cursor {
+  size_t in = 0;   // bytes consumed
+  size_t out = 0;  // values produced
+};
+
+// Classifies a register of input at a time by the continuation bits. A
+// register of single-byte values is widened straight into the output; any
+// other register is split at its terminators, each value being gathered
+// from one 8-byte load. The final register is left for the scalar tail so
+// that no load crosses the end of the input.
+template <typename Arch, std::unsigned_integral U>
+inline auto decode_varints_simd(const std::byte* p,
+                                size_t n,
+                                U* out,
+                                size_t count,
+                                varint_cursor& at) noexcept -> bool {
+  constexpr auto width = Arch::width;
+  auto start = at.in;
+  auto k = at.out;
+  for (size_t base = start; n - base >= width + 8 && k != count;
+       base += width) {
+    auto mask = static_cast<typename Arch::mask_type>(
+        ~Arch::msb(Arch::load(p + base)) & Arch::all);
+    if (mask == Arch::all && start == base && count - k >= width) {
+      for (size_t i = 0; i < width; ++i) {
+        out[k + i] = std::to_integer<U>(p[base + i]);
+      }
+      k += width;
+      start += width;
+      continue;
+    }
+    while (mask != 0 && k != count) {
+      auto const end = base + static_cast<size_t>(std::countr_zero(mask)) + 1;
+      mask &= mask - 1;
+      if (!decode_varint_known(p + start, end - start, out[k])) {
+        at = {start, k};
+        return false;
+      }
+      ++k;
+      start = end;
+    }
+  }
+  at = {start, k};
+  return true;
+}
+
+template <std::unsigned_integral U>
+constexpr auto decode_varints_unsigned(const std::byte* p,
+                                       size_t n,
+                                       U* out,
+                                       size_t count) noexcept
+    -> varint_batch_result {
+  auto at = varint_cursor{};
+  if constexpr (!std::is_void_v<simd::native>) {
+    if (!std::is_constant_evaluated()
+        && !decode_varints_simd<simd::native>(p, n, out, count, at))
+    {
+      return {at.out, at.in, byte_errc::invalid_encoding};
+    }
+  }
+  while (at.out != count && at.in != n) {
+    auto const r = decode_varint_scalar<U>(p + at.in, n - at.in);
+    if (!r) {
+      return {at.out, at.in, r.ec};
+    }
+    out[at.out++] = r.value;
+    at.in += r.size;
+  }
+  return {at.out, at.in, {}};
+}
+
+// Writes the encoding of `bits` and returns its length. Exactly that many
+// bytes are written, with at most two overlapping stores. With `wide`, the
+// encoding is stored as one 8-byte word instead, which also overwrites up
+// to seven bytes past it; the caller must own them and write them later.
+constexpr auto encode_varint_unchecked(std::byte* p,
+                                       std::uint64_t bits,
+                                       bool wide) noexcept -> size_t {
+  auto const len = varint_size_of(bits);
+  if (len <= 8 && !std::is_constant_evaluated()) {
+    auto const continuation =
+        0x8080808080808080U & ((std::uint64_t{1} << (8 * (len - 1))) - 1);
+    auto const word = varint_spread(bits) | continuation;
+    if (wide || len == 8) {
+      write_le<std::uint64_t>(p, word);
+    } else if (len >= 4) {
+      auto const back = word >> (8 * (len - 4));
+      write_le<std::uint32_t>(p, static_cast<std::uint32_t>(word));
+      write_le<std::uint32_t>(p + len - 4, static_cast<std::uint32_t>(back));
+    } else if (len >= 2) {
+      auto const back = word >> (8 * (len - 2));
+      write_le<std::uint16_t>(p, static_cast<std::uint16_t>(word));
+      write_le<std::uint16_t>(p + len - 2, static_cast<std::uint16_t>(back));
+    } else {
+      p[0] = static_cast<std::byte>(word);
+    }
+    return len;
+  }
+  for (size_t i = 0; i + 1 < len; ++i) {
+    p[i] = static_cast<std::byte>((bits & 0x7FU) | 0x80U);
+    bits >>= 7U;
+  }
+  p[len - 1] = static_cast<std::byte>(bits);
+  return len;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+}  // namespace detail
+
+// Length of the LEB128 encoding of `value`.
+template <detail::varint_value T>
+[[nodiscard]]
+constexpr auto varint_size(T value) noexcept -> size_t {
+  return detail::varint_size_of(detail::to_varint_bits(value));
+}
+
+// Decodes one LEB128 varint from the front of `in`. A truncated input reports
+// byte_errc::out_of_range; an encoding longer than max_varint_size<T> or one
+// that overflows T reports byte_errc::invalid_encoding.
+template <detail::varint_value T>
+[[nodiscard]]
+constexpr auto decode_varint(cbyte_view in) noexcept -> varint_result<T> {
+  using U = std::make_unsigned_t<T>;
+  auto const r = detail::decode_varint_scalar<U>(in.data(), in.size());
+  return {detail::from_varint_bits<T>(r.value), r.size, r.ec};
+}
+
+// Encodes `value` at the front of `out` and returns the number of bytes
+// written, or 0 if `out` is too small, in which case nothing is written.
+template <detail::varint_value T>
+constexpr auto encode_varint(byte_view out, T value) noexcept -> size_t {
+  auto const bits = detail::to_varint_bits(value);
+  if (out.size() < max_varint_size<T>
+      && out.size() < detail::varint_size_of(bits))
+  {
+    return 0;
+  }
+  return detail::encode_varint_unchecked(out.data(), bits, false);
+}
+
+// Decodes consecutive varints from `in` until `out` is full or `in` is
+// exhausted. `size` is the number of bytes consumed, so
+// `in.subspan(r.size)` resumes after the last decoded value. A trailing
+// partial varint stops the batch with byte_errc::out_of_range.
+template <detail::varint_value T, size_t Extent>
+constexpr auto decode_varints(cbyte_view in, std::span<T, Extent> out) noexcept
+    -> varint_batch_result {
+  using U = std::make_unsigned_t<T>;
+  if constexpr (std::is_signed_v<T>) {
+    // Decoded in place through the corresponding unsigned type, which may
+    // alias T.
+    auto const r = detail::decode_varints_unsigned(
+        in.data(), in.size(), reinterpret_cast<U*>(out.data()), out.size());
+    for (auto& v : out.first(r.count)) {
+      v = zigzag_decode(static_cast<U>(v));
+    }
+    return r;
+  } else {
+    return detail::decode_varints_unsigned(
+        in.data(), in.size(), out.data(), out.size());
+  }
+}
+
+// Encodes `values` into `out` until either runs out. A value that does not
+// fit stops the batch with byte_errc::out_of_range and is not written.
+template <detail::varint_value T, size_t Extent>
+constexpr auto encode_varints(std::span<T, Extent> values,
+                              byte_view out) noexcept -> varint_batch_result {
+  // A value may be stored as a whole word when the next eight values, which
+  // are at least eight bytes long, are sure to fit and overwrite the excess.
+  constexpr auto wide_room = 8 * max_varint_size<T>;
+  auto* p = out.data();
+  auto room = out.size();
+  size_t count = 0;
+  for (auto const v : values) {
+    auto const bits = detail::to_varint_bits(v);
+    if (room < max_varint_size<T> && room < detail::varint_size_of(bits)) {
+      return {count, out.size() - room, byte_errc::out_of_range};
+    }
+    auto const wide = values.size() - count >= 8 && room >= wide_room;
+    auto const len = detail::encode_varint_unchecked(p, bits, wide);
+    p += len;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    room -= len;
+    ++count;
+  }
+  return {count, out.size() - room, {}};
+}
+
+}  // namespace range3
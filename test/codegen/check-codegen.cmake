@@ -0,0 +1,120 @@
+# Compiles SOURCE to assembly with COMPILER at -O2 and checks that every
+# bs_<name> function is no bigger than its raw_<name> twin: no calls, no more
+# instructions and no more memory operands. Understands GCC and Clang output
+# for x86-64 (AT&T syntax) and AArch64.
+#
+# Usage: cmake -D COMPILER=... -D SOURCE=... -D INCLUDE_DIRS=... -D OUTPUT=...
+#              -P check-codegen.cmake
+
+foreach(var IN ITEMS COMPILER SOURCE INCLUDE_DIRS OUTPUT)
+  if(NOT DEFINED "${var}")
+    message(FATAL_ERROR "${var} is not defined")
+  endif()
+endforeach()
+
+set(include_flags "")
+foreach(dir IN LISTS INCLUDE_DIRS)
+  list(APPEND include_flags "-I${dir}")
+endforeach()
+
+execute_process(
+    COMMAND "${COMPILER}" -std=c++20 -O2 -DNDEBUG -S
+    -fno-asynchronous-unwind-tables -fno-exceptions
+    ${include_flags} "${SOURCE}" -o "${OUTPUT}"
+    RESULT_VARIABLE result
+    ERROR_VARIABLE error
+)
+if(NOT result EQUAL "0")
+  message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${error}")
+endif()
+
+# ---- Split the assembly into functions ----
+
+file(READ "${OUTPUT}" asm)
+string(REPLACE ";" "" asm "${asm}")
+string(REPLACE "\n" ";" lines "${asm}")
+
+set(function "")
+set(functions "")
+foreach(line IN LISTS lines)
+  string(STRIP "${line}" text)
+  # Any non-local label ends the current function.
+  if(text MATCHES "^([A-Za-z_$][A-Za-z0-9_$.]*):")
+    set(label "${CMAKE_MATCH_1}")
+    if(label MATCHES "^L")
+      continue()
+    endif()
+    set(function "")
+    if(label MATCHES "^_?((bs|raw)_[A-Za-z0-9_]+)$")
+      set(function "${CMAKE_MATCH_1}")
+      list(APPEND functions "${function}")
+      set("count_${function}" 0)
+      set("memory_${function}" 0)
+      set("calls_${function}" "")
+      set("body_${function}" "")
+    endif()
+    continue()
+  endif()
+  if(function STREQUAL "")
+    continue()
+  endif()
+  # Comments, directives and local labels
+  string(REGEX REPLACE "(^#| # |//).*" "" text "${text}")
+  string(STRIP "${text}" text)
+  if(text STREQUAL "" OR text MATCHES "^\\." OR text MATCHES ":$")
+    continue()
+  endif()
+
+  string(APPEND "body_${function}" "    ${text}\n")
+  math(EXPR "count_${function}" "${count_${function}} + 1")
+  if(text MATCHES "\\(|\\[")
+    math(EXPR "memory_${function}" "${memory_${function}} + 1")
+  endif()
+  if(text MATCHES "^(call[a-z]*|blr?)[ \t]"
+     OR text MATCHES "^(jmp|b)[ \t]+([^.L][^ \t]*)$")
+    list(APPEND "calls_${function}" "${text}")
+  endif()
+endforeach()
+
+# ---- Compare the twins ----
+
+set(failures "")
+set(checked 0)
+foreach(function IN LISTS functions)
+  if(NOT function MATCHES "^bs_(.*)$")
+    continue()
+  endif()
+  set(twin "raw_${CMAKE_MATCH_1}")
+  if(NOT DEFINED "count_${twin}")
+    string(APPEND failures "${function}: no ${twin} to compare with\n")
+    continue()
+  endif()
+  math(EXPR checked "${checked} + 1")
+
+  set(problems "")
+  if(NOT "${calls_${function}}" STREQUAL "")
+    list(APPEND problems "emits ${calls_${function}}")
+  endif()
+  if(count_${function} GREATER count_${twin})
+    list(APPEND problems
+         "${count_${function}} instructions, ${twin} has ${count_${twin}}")
+  endif()
+  if(memory_${function} GREATER memory_${twin})
+    list(APPEND problems
+         "${memory_${function}} memory operands, ${twin} has ${memory_${twin}}")
+  endif()
+  if(NOT problems STREQUAL "")
+    string(REPLACE ";" ", " problems "${problems}")
+    string(APPEND failures "${function}: ${problems}\n"
+           "  ${function}:\n${body_${function}}"
+           "  ${twin}:\n${body_${twin}}")
+  endif()
+endforeach()
+
+if(NOT failures STREQUAL "")
+  message(FATAL_ERROR "Abstraction penalties in ${OUTPUT}:\n${failures}")
+endif()
+if(checked EQUAL "0")
+  message(FATAL_ERROR "No bs_/raw_ function pairs found in ${OUTPUT}")
+endif()
+message(STATUS "${checked} functions compile to their raw-pointer twins")
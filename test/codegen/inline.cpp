@@ -0,0 +1,153 @@
+// Pairs of functions compiled to assembly by check-codegen.cmake. Every
+// bs_<name> uses byte_span and must compile to no more instructions and no
+// more memory operands than its raw-pointer twin raw_<name>, and must not
+// call anything. Keep the twins doing exactly the same work.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/endian.hpp"
+#include "byte_span/layout.hpp"
+
+using range3::byte_span;
+using range3::cbyte_view;
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+
+extern "C" {
+
+// Iterator and sentinel
+auto bs_iter_sentinel(const std::uint32_t* first, const std::uint32_t* last)
+    -> size_t {
+  return cbyte_view{first, last}.size();
+}
+auto raw_iter_sentinel(const std::uint32_t* first, const std::uint32_t* last)
+    -> size_t {
+  return static_cast<size_t>(last - first) * sizeof(std::uint32_t);
+}
+
+// Iterator and count, then indexing
+auto bs_index(const char* p, size_t n, size_t i) -> unsigned {
+  return std::to_integer<unsigned>(cbyte_view{p, n}[i]);
+}
+auto raw_index(const char* p, size_t /*n*/, size_t i) -> unsigned {
+  return static_cast<unsigned char>(p[i]);
+}
+
+// Contiguous range
+auto bs_range(const std::vector<std::uint64_t>& v) -> size_t {
+  return cbyte_view{v}.size();
+}
+auto raw_range(const std::vector<std::uint64_t>& v) -> size_t {
+  return v.size() * sizeof(std::uint64_t);
+}
+
+// std::span
+auto bs_std_span(const std::uint16_t* p, size_t n) -> unsigned {
+  auto const bytes = cbyte_view{std::span{p, n}};
+  return std::to_integer<unsigned>(bytes[bytes.size() - 1]);
+}
+auto raw_std_span(const std::uint16_t* p, size_t n) -> unsigned {
+  return reinterpret_cast<const unsigned char*>(p)[(n * 2) - 1];
+}
+
+// void* and size
+auto bs_void(const void* p, size_t n) -> unsigned {
+  return std::to_integer<unsigned>(cbyte_view{p, n}.last(1)[0]);
+}
+auto raw_void(const void* p, size_t n) -> unsigned {
+  return static_cast<const unsigned char*>(p)[n - 1];
+}
+
+// Static sub-views and as_value
+auto bs_as_value(const std::byte* p) -> std::uint32_t {
+  auto const header = byte_span<const std::byte, 16>{p, 16};
+  return range3::as_value<std::uint32_t>(header.subspan<4, 4>());
+}
+auto raw_as_value(const std::byte* p) -> std::uint32_t {
+  return *reinterpret_cast<const std::uint32_t*>(p + 4);
+}
+
+// as_span in a loop
+auto bs_as_span(const std::byte* p, size_t n) -> std::uint32_t {
+  std::uint32_t sum = 0;
+  for (auto const v : range3::as_span<std::uint32_t>(cbyte_view{p, n})) {
+    sum += v;
+  }
+  return sum;
+}
+auto raw_as_span(const std::byte* p, size_t n) -> std::uint32_t {
+  const auto* const words = reinterpret_cast<const std::uint32_t*>(p);
+  std::uint32_t sum = 0;
+  for (size_t i = 0; i < n / 4; ++i) {
+    sum += words[i];
+  }
+  return sum;
+}
+
+// Iteration over bytes
+auto bs_iterate(const std::byte* p, size_t n) -> unsigned {
+  unsigned sum = 0;
+  for (auto const b : cbyte_view{p, n}) {
+    sum += std::to_integer<unsigned>(b);
+  }
+  return sum;
+}
+auto raw_iterate(const std::byte* p, size_t n) -> unsigned {
+  unsigned sum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    sum += std::to_integer<unsigned>(p[i]);
+  }
+  return sum;
+}
+
+// Big-endian load at an offset
+auto bs_load_be(const std::byte* p, size_t n) -> std::uint32_t {
+  return range3::load_be<std::uint32_t>(cbyte_view{p, n}, 2);
+}
+auto raw_load_be(const std::byte* p, size_t /*n*/) -> std::uint32_t {
+  std::uint32_t v = 0;
+  std::memcpy(&v, p + 2, sizeof(v));
+  if constexpr (std::endian::native == std::endian::little) {
+    v = __builtin_bswap32(v);
+  }
+  return v;
+}
+
+// Layout field read
+auto bs_layout_get(const std::byte* p) -> std::uint32_t {
+  using length = range3::be_field<std::uint32_t, 8>;
+  using header = range3::layout<16, length>;
+  return header::get<length>(byte_span<const std::byte, 16>{p, 16});
+}
+auto raw_layout_get(const std::byte* p) -> std::uint32_t {
+  std::uint32_t v = 0;
+  std::memcpy(&v, p + 8, sizeof(v));
+  if constexpr (std::endian::native == std::endian::little) {
+    v = __builtin_bswap32(v);
+  }
+  return v;
+}
+
+// Layout field write
+void bs_layout_set(std::byte* p, std::uint16_t v) {
+  range3::set<range3::le_field<std::uint16_t, 6>>(
+      byte_span<std::byte, 8>{p, 8}, v);
+}
+void raw_layout_set(std::byte* p, std::uint16_t v) {
+  if constexpr (std::endian::native == std::endian::big) {
+    v = __builtin_bswap16(v);
+  }
+  std::memcpy(p + 6, &v, sizeof(v));
+}
+
+}  // extern "C"
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
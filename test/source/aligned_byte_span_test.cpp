@@ -0,0 +1,115 @@
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/aligned_byte_span.hpp"
+#include "byte_span/byte_span.hpp"
+
+using range3::aligned_byte_span;
+using range3::aligned_byte_view;
+using range3::aligned_cbyte_view;
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::dynamic_extent;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto size_of(cbyte_view bytes) -> size_t {
+  return bytes.size();
+}
+
+template <size_t Align>
+auto alignment_of(aligned_cbyte_view<Align> /*bytes*/) -> size_t {
+  return Align;
+}
+
+}  // namespace
+
+TEST_CASE("aligned_byte_span is a byte_span", "[aligned_byte_span]") {
+  STATIC_REQUIRE(std::ranges::contiguous_range<aligned_byte_view<64>>);
+  STATIC_REQUIRE(std::ranges::view<aligned_byte_view<64>>);
+  STATIC_REQUIRE(std::ranges::borrowed_range<aligned_byte_view<64>>);
+  STATIC_REQUIRE(sizeof(aligned_byte_view<64>) == sizeof(byte_view));
+
+  // Implicit towards plain spans and weaker alignment
+  STATIC_REQUIRE(std::is_convertible_v<aligned_byte_view<64>, byte_view>);
+  STATIC_REQUIRE(std::is_convertible_v<aligned_byte_view<64>, cbyte_view>);
+  STATIC_REQUIRE(std::is_convertible_v<aligned_byte_view<64>,
+                                       aligned_cbyte_view<16>>);
+  STATIC_REQUIRE(
+      std::is_convertible_v<aligned_byte_span<std::byte, 32, 64>,
+                            range3::byte_span<const std::byte, 32>>);
+  // Checked, hence explicit, the other way
+  STATIC_REQUIRE_FALSE(
+      std::is_convertible_v<byte_view, aligned_byte_view<64>>);
+  STATIC_REQUIRE(std::is_constructible_v<aligned_byte_view<64>, byte_view>);
+  STATIC_REQUIRE_FALSE(std::is_convertible_v<aligned_byte_view<16>,
+                                             aligned_byte_view<64>>);
+  STATIC_REQUIRE(std::is_constructible_v<aligned_byte_view<64>,
+                                         aligned_byte_view<16>>);
+  STATIC_REQUIRE_FALSE(std::is_constructible_v<aligned_byte_view<64>,
+                                               aligned_cbyte_view<64>>);
+
+  alignas(64) std::array<std::byte, 256> storage{};
+  aligned_byte_view<64> a{storage};
+  REQUIRE(a.data() == storage.data());
+  REQUIRE(a.size() == 256);
+  REQUIRE(size_of(a) == 256);
+  REQUIRE(alignment_of<16>(a) == 16);
+  REQUIRE(range3::as_sv(a).size() == 256);
+  REQUIRE(range3::is_aligned<64>(cbyte_view{a}));
+  REQUIRE_FALSE(range3::is_aligned<64>(cbyte_view{a}.subspan(8)));
+  REQUIRE(range3::is_aligned<8>(cbyte_view{a}.subspan(8)));
+}
+
+TEST_CASE("aligned_byte_span propagates alignment", "[aligned_byte_span]") {
+  alignas(64) std::array<std::byte, 256> storage{};
+  aligned_byte_span<std::byte, 256, 64> a{storage};
+
+  auto head = a.first<128>();
+  STATIC_REQUIRE(
+      std::is_same_v<decltype(head), aligned_byte_span<std::byte, 128, 64>>);
+  auto runtime_head = a.first(10);
+  STATIC_REQUIRE(
+      std::is_same_v<decltype(runtime_head), aligned_byte_view<64>>);
+
+  auto at64 = a.subspan<64>();
+  STATIC_REQUIRE(
+      std::is_same_v<decltype(at64), aligned_byte_span<std::byte, 192, 64>>);
+  auto at48 = a.subspan<48, 16>();
+  STATIC_REQUIRE(
+      std::is_same_v<decltype(at48), aligned_byte_span<std::byte, 16, 16>>);
+  auto at3 = a.subspan<3>();
+  STATIC_REQUIRE(decltype(at3)::alignment == 1);
+  REQUIRE(at48.data() == storage.data() + 48);
+  REQUIRE(range3::is_aligned<16>(at48.data()));
+
+  auto tail = a.last<32>();
+  STATIC_REQUIRE(
+      std::is_same_v<decltype(tail), aligned_byte_span<std::byte, 32, 32>>);
+  REQUIRE(tail.data() == storage.data() + 224);
+
+  // Runtime offsets give up the guarantee.
+  aligned_byte_view<64> dynamic{storage};
+  STATIC_REQUIRE(std::is_same_v<decltype(dynamic.subspan(64)), byte_view>);
+  STATIC_REQUIRE(std::is_same_v<decltype(dynamic.last<8>()),
+                                range3::byte_span<std::byte, 8>>);
+  STATIC_REQUIRE(std::is_same_v<decltype(dynamic.subspan<128>()),
+                                aligned_byte_view<64>>);
+  REQUIRE(dynamic.subspan<128>().size() == 128);
+}
+
+TEST_CASE("aligned_byte_span is constexpr", "[aligned_byte_span]") {
+  static constexpr std::array<std::byte, 64> bytes{};
+  constexpr aligned_byte_span<const std::byte, 64, 1> s{bytes};
+  STATIC_REQUIRE(s.first<16>().size() == 16);
+  STATIC_REQUIRE(s.subspan<8>().size() == 56);
+}
+
+// NOLINTEND(misc-const-correctness)
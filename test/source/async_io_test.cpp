@@ -0,0 +1,264 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/async_io.hpp"
+#include "byte_span/byte_span.hpp"
+
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::io_backend;
+using range3::io_completion;
+using range3::io_queue;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+// An unlinked temporary file, closed on destruction.
+struct temp_fd {
+  int fd = -1;
+
+  temp_fd() {
+    char path[] = "/tmp/byte_span_async_io_XXXXXX";
+    fd = ::mkstemp(path);
+    REQUIRE(fd != -1);
+    ::unlink(path);
+  }
+  temp_fd(const temp_fd&) = delete;
+  auto operator=(const temp_fd&) -> temp_fd& = delete;
+  temp_fd(temp_fd&&) = delete;
+  auto operator=(temp_fd&&) -> temp_fd& = delete;
+  ~temp_fd() { ::close(fd); }
+};
+
+// Every backend usable here: the thread pool always, io_uring when the
+// kernel allows it.
+auto backends() -> std::vector<io_backend> {
+  std::vector<io_backend> out{io_backend::thread_pool};
+  if (io_queue::supported(io_backend::io_uring)) {
+    out.push_back(io_backend::io_uring);
+  }
+  return out;
+}
+
+auto queue_for(io_backend backend) -> range3::io_queue_options {
+  return {.entries = 8, .threads = 3, .backend = backend};
+}
+
+// Starts eagerly and destroys itself when done; the test drives it with
+// io_queue::drain().
+struct detached {
+  struct promise_type {
+    auto get_return_object() noexcept -> detached { return {}; }
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() noexcept -> std::suspend_never { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+auto copy_file(io_queue& q, int from, int to, size_t size, size_t& copied)
+    -> detached {
+  std::array<char, 7> chunk{};
+  std::uint64_t offset = 0;
+  while (offset < size) {
+    auto const r = co_await q.async_read(from, byte_view{chunk}, offset);
+    if (!r || r.size == 0) {
+      co_return;
+    }
+    auto const w = co_await q.async_write(
+        to, cbyte_view{chunk}.first(r.size), offset);
+    if (!w) {
+      co_return;
+    }
+    offset += w.size;
+  }
+  copied = offset;
+}
+
+}  // namespace
+
+TEST_CASE("io_queue resolves its backend", "[async_io]") {
+  REQUIRE(io_queue::supported(io_backend::thread_pool));
+  REQUIRE(io_queue::supported(io_backend::automatic));
+
+  io_queue automatic;
+  REQUIRE(automatic.backend() != io_backend::automatic);
+  if (io_queue::supported(io_backend::io_uring)) {
+    REQUIRE(automatic.backend() == io_backend::io_uring);
+  } else {
+    REQUIRE_THROWS_AS(io_queue{queue_for(io_backend::io_uring)},
+                      std::system_error);
+  }
+  io_queue pool{queue_for(io_backend::thread_pool)};
+  REQUIRE(pool.backend() == io_backend::thread_pool);
+}
+
+TEST_CASE("io_queue reads and writes with callbacks", "[async_io]") {
+  for (auto const backend : backends()) {
+    io_queue q{queue_for(backend)};
+    temp_fd file;
+
+    auto const text = "asynchronous bytes"sv;
+    io_completion wrote;
+    q.write(file.fd, cbyte_view{text}, 100, [&](io_completion c) {
+      wrote = c;
+    });
+    REQUIRE(q.pending() == 1);
+    REQUIRE(q.wait() == 1);
+    REQUIRE(q.pending() == 0);
+    REQUIRE(wrote);
+    REQUIRE(wrote.size == text.size());
+
+    std::array<char, 12> buf{};
+    io_completion got;
+    q.read(file.fd, byte_view{buf}, 106, [&](io_completion c) { got = c; });
+    q.drain();
+    REQUIRE(got.size == buf.size());
+    REQUIRE(std::string_view{buf.data(), buf.size()} == "ronous bytes");
+
+    // Reading at the end of the file transfers nothing.
+    q.read(file.fd, byte_view{buf}, 4096, [&](io_completion c) { got = c; });
+    q.drain();
+    REQUIRE(got);
+    REQUIRE(got.size == 0);
+  }
+}
+
+TEST_CASE("io_queue submits operations in batches", "[async_io]") {
+  for (auto const backend : backends()) {
+    io_queue q{queue_for(backend)};
+    temp_fd file;
+
+    // More operations than the queue depth, so the ring fills and is flushed
+    // while they are being queued.
+    constexpr size_t count = 100;
+    std::vector<std::uint32_t> values(count);
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+      values[i] = static_cast<std::uint32_t>(i * 2654435761U);
+      q.write(file.fd,
+              cbyte_view{&values[i], 1},
+              i * sizeof(std::uint32_t),
+              [&](io_completion c) { written += c.size; });
+    }
+    q.drain();
+    REQUIRE(written == count * sizeof(std::uint32_t));
+
+    std::vector<std::uint32_t> back(count);
+    size_t done = 0;
+    for (size_t i = 0; i < count; ++i) {
+      q.read(file.fd,
+             byte_view{&back[i], 1},
+             i * sizeof(std::uint32_t),
+             [&](io_completion c) {
+               if (c) {
+                 ++done;
+               }
+             });
+    }
+    REQUIRE(q.submit() > 0);
+    while (q.pending() != 0) {
+      q.wait();
+      q.poll();
+    }
+    REQUIRE(done == count);
+    REQUIRE(back == values);
+  }
+}
+
+TEST_CASE("io_queue fixed operations use registered buffers", "[async_io]") {
+  for (auto const backend : backends()) {
+    io_queue q{queue_for(backend)};
+    temp_fd file;
+
+    std::vector<std::byte> arena(8192);
+    std::array<byte_view, 2> const buffers{
+        byte_view{arena}.first(4096), byte_view{arena}.subspan(4096)};
+    q.register_buffers(buffers);
+
+    auto out = buffers[0].first(10);
+    std::memcpy(out.data(), "fixed data", out.size());
+    io_completion wrote;
+    q.write_fixed(file.fd, out, 0, 0, [&](io_completion c) { wrote = c; });
+    q.drain();
+    REQUIRE(wrote.size == 10);
+
+    auto in = buffers[1].subspan(100, 5);
+    io_completion got;
+    q.read_fixed(file.fd, in, 1, 6, [&](io_completion c) { got = c; });
+    q.drain();
+    REQUIRE(got.size == 4);  // stops at the end of the file
+    REQUIRE(range3::as_sv(in.first(4)) == "data");
+
+    q.unregister_buffers();
+    q.register_buffers(buffers);
+  }
+}
+
+TEST_CASE("io_queue operations report errors", "[async_io]") {
+  for (auto const backend : backends()) {
+    io_queue q{queue_for(backend)};
+
+    std::array<char, 4> buf{};
+    io_completion got;
+    q.read(-1, byte_view{buf}, 0, [&](io_completion c) { got = c; });
+    q.drain();
+    REQUIRE_FALSE(got);
+    REQUIRE(got.ec == std::errc::bad_file_descriptor);
+
+    // A read-only descriptor cannot be written.
+    int const ro = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    REQUIRE(ro != -1);
+    q.write(ro, cbyte_view{"x"sv}, 0, [&](io_completion c) { got = c; });
+    q.drain();
+    ::close(ro);
+    REQUIRE(got.ec == std::errc::bad_file_descriptor);
+  }
+}
+
+TEST_CASE("io_queue operations can be awaited", "[async_io]") {
+  for (auto const backend : backends()) {
+    io_queue q{queue_for(backend)};
+    temp_fd from;
+    temp_fd to;
+
+    std::string text;
+    for (int i = 0; i < 50; ++i) {
+      text += "line " + std::to_string(i) + "\n";
+    }
+    REQUIRE(::pwrite(from.fd, text.data(), text.size(), 0)
+            == static_cast<::ssize_t>(text.size()));
+
+    size_t copied = 0;
+    copy_file(q, from.fd, to.fd, text.size(), copied);
+    REQUIRE(q.pending() == 1);  // suspended on the first read
+    q.drain();
+    REQUIRE(copied == text.size());
+
+    std::string back(text.size(), '\0');
+    REQUIRE(::pread(to.fd, back.data(), back.size(), 0)
+            == static_cast<::ssize_t>(back.size()));
+    REQUIRE(back == text);
+  }
+}
+
+// NOLINTEND(misc-const-correctness)
+
+#endif
@@ -0,0 +1,184 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/base64.hpp"
+#include "byte_span/byte_span.hpp"
+
+using range3::base64_alphabet;
+using range3::byte_errc;
+using range3::byte_view;
+using range3::cbyte_view;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto random_bytes(size_t count) -> std::vector<std::byte> {
+  std::mt19937 rng{static_cast<unsigned>(count)};
+  std::vector<std::byte> out(count);
+  for (auto& b : out) {
+    b = static_cast<std::byte>(rng());
+  }
+  return out;
+}
+
+// Bit-at-a-time reference encoder
+auto reference_base64(const std::vector<std::byte>& bytes,
+                      base64_alphabet alphabet) -> std::string {
+  std::string chars =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  if (alphabet == base64_alphabet::url) {
+    chars[62] = '-';
+    chars[63] = '_';
+  }
+  std::string out;
+  std::uint32_t acc = 0;
+  unsigned bits = 0;
+  for (auto const b : bytes) {
+    acc = (acc << 8U) | std::to_integer<std::uint32_t>(b);
+    bits += 8;
+    while (bits >= 6) {
+      bits -= 6;
+      out += chars[(acc >> bits) & 0x3FU];
+    }
+  }
+  if (bits != 0) {
+    out += chars[(acc << (6 - bits)) & 0x3FU];
+  }
+  if (alphabet == base64_alphabet::standard) {
+    while (out.size() % 4 != 0) {
+      out += '=';
+    }
+  }
+  return out;
+}
+
+auto decode(std::string_view text,
+            base64_alphabet alphabet = base64_alphabet::standard)
+    -> std::pair<range3::decode_result, std::string> {
+  std::string out(range3::base64_decoded_size(cbyte_view{text}), '\0');
+  auto const r = range3::base64_decode(cbyte_view{text}, byte_view{out},
+                                       alphabet);
+  out.resize(r.size);
+  return {r, out};
+}
+
+}  // namespace
+
+TEST_CASE("base64 matches the RFC 4648 test vectors", "[base64]") {
+  constexpr std::array<std::pair<std::string_view, std::string_view>, 7>
+      vectors = {{{"", ""},
+                  {"f", "Zg=="},
+                  {"fo", "Zm8="},
+                  {"foo", "Zm9v"},
+                  {"foob", "Zm9vYg=="},
+                  {"fooba", "Zm9vYmE="},
+                  {"foobar", "Zm9vYmFy"}}};
+  for (auto const& [plain, encoded] : vectors) {
+    REQUIRE(range3::to_base64(cbyte_view{plain}) == encoded);
+    auto const [r, decoded] = decode(encoded);
+    REQUIRE(r);
+    REQUIRE(r.offset == encoded.size());
+    REQUIRE(decoded == plain);
+  }
+  REQUIRE(range3::to_base64(cbyte_view{"fo"sv}, base64_alphabet::url)
+          == "Zm8");
+  REQUIRE(decode("Zm8"sv).second == "fo");
+}
+
+TEST_CASE("base64 sizes are exact", "[base64]") {
+  for (size_t n = 0; n < 10; ++n) {
+    auto const bytes = random_bytes(n);
+    for (auto const alphabet : {base64_alphabet::standard,
+                                base64_alphabet::url})
+    {
+      auto const text = range3::to_base64(cbyte_view{bytes}, alphabet);
+      REQUIRE(text.size() == range3::base64_encoded_size(n, alphabet));
+      REQUIRE(range3::base64_decoded_size(cbyte_view{text}) == n);
+    }
+  }
+}
+
+TEST_CASE("base64 round-trips across kernel boundaries", "[base64]") {
+  for (size_t n : {1U, 2U, 23U, 24U, 27U, 28U, 29U, 48U, 100U, 1000U, 4099U})
+  {
+    auto const bytes = random_bytes(n);
+    for (auto const alphabet : {base64_alphabet::standard,
+                                base64_alphabet::url})
+    {
+      auto const text = range3::to_base64(cbyte_view{bytes}, alphabet);
+      REQUIRE(text == reference_base64(bytes, alphabet));
+
+      std::vector<std::byte> decoded(range3::base64_decoded_size(
+          cbyte_view{text}));
+      auto const r = range3::base64_decode(
+          cbyte_view{text}, byte_view{decoded}, alphabet);
+      REQUIRE(r);
+      REQUIRE(r.size == n);
+      REQUIRE(decoded == bytes);
+    }
+  }
+}
+
+TEST_CASE("base64_decode does not write past the decoded size",
+          "[base64]") {
+  auto const bytes = random_bytes(300);
+  auto const text = range3::to_base64(cbyte_view{bytes});
+  std::vector<std::byte> decoded(400, std::byte{0xEE});
+  auto const r = range3::base64_decode(cbyte_view{text}, byte_view{decoded});
+  REQUIRE(r.size == 300);
+  for (size_t i = 300; i < decoded.size(); ++i) {
+    REQUIRE(decoded[i] == std::byte{0xEE});
+  }
+}
+
+TEST_CASE("base64_decode reports the first invalid character", "[base64]") {
+  auto const text = range3::to_base64(cbyte_view{random_bytes(120)});
+  for (size_t at : {0U, 5U, 31U, 32U, 47U, 64U, 100U, 159U}) {
+    for (char bad : {'-', '_', '=', '.', ' ', '\n', '\x80'}) {
+      if (bad == '=' && at + 1 == text.size()) {
+        continue;  // may form valid padding
+      }
+      auto corrupt = text;
+      corrupt[at] = bad;
+      auto const [r, decoded] = decode(corrupt);
+      REQUIRE(r.ec == byte_errc::invalid_encoding);
+      REQUIRE(r.offset == at);
+      REQUIRE(r.size == at / 4 * 3);
+    }
+  }
+  auto const url = range3::to_base64(cbyte_view{random_bytes(120)},
+                                     base64_alphabet::url);
+  auto corrupt = url;
+  corrupt[70] = '+';
+  auto const r = decode(corrupt, base64_alphabet::url).first;
+  REQUIRE(r.ec == byte_errc::invalid_encoding);
+  REQUIRE(r.offset == 70);
+}
+
+TEST_CASE("base64_decode validates padding and trailing bits", "[base64]") {
+  auto check = [](std::string_view text, byte_errc ec, size_t offset) {
+    auto const r = decode(text).first;
+    REQUIRE(r.ec == ec);
+    REQUIRE(r.offset == offset);
+  };
+  check("Zg=="sv, {}, 4);
+  check("Zg"sv, {}, 2);
+  check("Zm8="sv, {}, 4);
+  check("Zh=="sv, byte_errc::invalid_encoding, 1);  // non-zero spare bits
+  check("Zm9=", byte_errc::invalid_encoding, 2);
+  check("Zg==Zg=="sv, byte_errc::invalid_encoding, 2);
+  check("Z=g="sv, byte_errc::invalid_encoding, 1);
+  check("Z==="sv, byte_errc::invalid_encoding, 1);
+  check("Zm9vY"sv, byte_errc::out_of_range, 4);
+}
+
+// NOLINTEND(misc-const-correctness)
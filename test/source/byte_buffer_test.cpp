@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <ranges>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_buffer.hpp"
+#include "byte_span/byte_span.hpp"
+#include "byte_span/byte_writer.hpp"
+
+using range3::byte_buffer;
+using range3::byte_view;
+using range3::cbyte_view;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto address(const void* p) -> std::uintptr_t {
+  return reinterpret_cast<std::uintptr_t>(p);  // NOLINT
+}
+
+// Counts live allocations and fills fresh memory with 0xAA, so bytes left
+// uninitialized by the buffer are recognizable.
+template <typename T>
+struct poisoning_allocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::false_type;
+
+  int* live;
+  int id;
+
+  poisoning_allocator(int* counter, int tag) noexcept
+      : live{counter}, id{tag} {}
+
+  auto allocate(size_t n) -> T* {
+    auto* p = std::allocator<T>{}.allocate(n);
+    std::ranges::fill(std::span{p, n}, T{0xAA});
+    ++*live;
+    return p;
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    std::allocator<T>{}.deallocate(p, n);
+    --*live;
+  }
+
+  friend auto operator==(const poisoning_allocator& a,
+                         const poisoning_allocator& b) noexcept -> bool {
+    return a.id == b.id;
+  }
+};
+
+auto fill_view(byte_view out, std::byte value) -> size_t {
+  std::ranges::fill(out, value);
+  return out.size();
+}
+
+auto sum_view(cbyte_view in) -> unsigned {
+  unsigned sum = 0;
+  for (auto const b : in) {
+    sum += std::to_integer<unsigned>(b);
+  }
+  return sum;
+}
+
+}  // namespace
+
+TEST_CASE("byte_buffer is a contiguous byte range", "[byte_buffer]") {
+  STATIC_REQUIRE(std::ranges::contiguous_range<byte_buffer>);
+  STATIC_REQUIRE(std::ranges::sized_range<byte_buffer>);
+  STATIC_REQUIRE(std::is_convertible_v<byte_buffer&, byte_view>);
+  STATIC_REQUIRE(std::is_convertible_v<const byte_buffer&, cbyte_view>);
+  STATIC_REQUIRE_FALSE(std::is_convertible_v<const byte_buffer&, byte_view>);
+  STATIC_REQUIRE(byte_buffer::alignment == 64);
+  STATIC_REQUIRE(range3::direct_io_buffer::alignment == 4096);
+
+  byte_buffer buf(100);
+  REQUIRE(buf.size() == 100);
+  REQUIRE(sum_view(buf) == 0);
+  REQUIRE(fill_view(buf, std::byte{1}) == 100);
+  REQUIRE(sum_view(buf) == 100);
+
+  byte_view view = buf;
+  REQUIRE(view.data() == buf.data());
+  REQUIRE(view.size() == buf.size());
+  REQUIRE(range3::as_sv(byte_view{buf}.first(2)) == "\x01\x01"sv);
+}
+
+TEST_CASE("byte_buffer storage is aligned", "[byte_buffer]") {
+  byte_buffer a;
+  REQUIRE(a.empty());
+  REQUIRE(a.data() == nullptr);
+  for (size_t n : {1U, 63U, 64U, 1000U, 100000U}) {
+    a.resize(n);
+    REQUIRE(address(a.data()) % 64 == 0);
+  }
+
+  range3::direct_io_buffer d(10000, range3::for_overwrite);
+  REQUIRE(address(d.data()) % 4096 == 0);
+  d.shrink_to_fit();
+  REQUIRE(address(d.data()) % 4096 == 0);
+
+  int live = 0;
+  range3::basic_byte_buffer<256, poisoning_allocator<std::byte>> c{
+      poisoning_allocator<std::byte>{&live, 1}};
+  for (size_t n : {3U, 300U, 3000U}) {
+    c.resize(n);
+    REQUIRE(address(c.data()) % 256 == 0);
+  }
+  REQUIRE(live == 1);
+  c.shrink_to_fit();
+  c.clear();
+  c.shrink_to_fit();
+  REQUIRE(live == 0);
+}
+
+TEST_CASE("byte_buffer resize_for_overwrite skips zero-filling",
+          "[byte_buffer]") {
+  int live = 0;
+  using buffer =
+      range3::basic_byte_buffer<64, poisoning_allocator<std::byte>>;
+  poisoning_allocator<std::byte> const alloc{&live, 1};
+
+  buffer b{alloc};
+  b.resize_for_overwrite(32);
+  REQUIRE(std::ranges::count(b, std::byte{0xAA}) == 32);
+  b.resize(16);
+  b.resize(40);
+  // Bytes beyond the old size are zeroed again, even within capacity.
+  REQUIRE(std::ranges::count(byte_view{b}.subspan(16), std::byte{}) == 24);
+  b.resize(48, std::byte{7});
+  REQUIRE(b[47] == std::byte{7});
+
+  buffer c{100, range3::for_overwrite, alloc};
+  REQUIRE(c.size() == 100);
+  REQUIRE(c[99] == std::byte{0xAA});
+  buffer z{100, alloc};
+  REQUIRE(std::ranges::count(z, std::byte{}) == 100);
+}
+
+TEST_CASE("byte_buffer appends and inserts", "[byte_buffer]") {
+  byte_buffer b{cbyte_view{"world"sv}};
+  b.insert(b.begin(), "hello "sv.begin(), "hello "sv.end());
+  b.push_back(std::byte{'!'});
+  REQUIRE(range3::as_sv(cbyte_view{b}) == "hello world!");
+
+  auto const before = b.capacity();
+  b.reserve(before + 100);
+  REQUIRE(b.capacity() >= before + 100);
+  REQUIRE(range3::as_sv(cbyte_view{b}) == "hello world!");
+
+  // The inserted range may come from the buffer itself.
+  b.insert(b.end(), b.begin(), b.begin() + 5);
+  REQUIRE(range3::as_sv(cbyte_view{b}) == "hello world!hello");
+  b.append(cbyte_view{b}.subspan(5, 7));
+  REQUIRE(range3::as_sv(cbyte_view{b}) == "hello world!hello world!");
+
+  byte_buffer big;
+  for (int i = 0; i < 10000; ++i) {
+    big.push_back(static_cast<std::byte>(i));
+  }
+  REQUIRE(big.size() == 10000);
+  REQUIRE(big[9999] == std::byte{9999 & 0xFF});
+}
+
+TEST_CASE("byte_buffer copies and moves", "[byte_buffer]") {
+  byte_buffer a{cbyte_view{"payload"sv}};
+  byte_buffer b = a;
+  REQUIRE(b.data() != a.data());
+  REQUIRE(range3::as_sv(cbyte_view{b}) == "payload");
+
+  auto const* storage = a.data();
+  byte_buffer c = std::move(a);
+  REQUIRE(c.data() == storage);
+  REQUIRE(a.empty());  // NOLINT(bugprone-use-after-move)
+
+  b = c;
+  REQUIRE(range3::as_sv(cbyte_view{b}) == "payload");
+  a = std::move(c);
+  REQUIRE(a.data() == storage);
+  swap(a, b);
+  REQUIRE(b.data() == storage);
+
+  // Moving between unequal allocators that do not propagate copies.
+  int live = 0;
+  using buffer =
+      range3::basic_byte_buffer<64, poisoning_allocator<std::byte>>;
+  buffer x{cbyte_view{"xyz"sv}, poisoning_allocator<std::byte>{&live, 1}};
+  buffer y{poisoning_allocator<std::byte>{&live, 2}};
+  y = std::move(x);
+  REQUIRE(range3::as_sv(cbyte_view{y}) == "xyz");
+  REQUIRE(y.get_allocator().id == 2);
+  buffer w{std::move(y), poisoning_allocator<std::byte>{&live, 2}};
+  REQUIRE(range3::as_sv(cbyte_view{w}) == "xyz");
+  REQUIRE(y.empty());  // NOLINT(bugprone-use-after-move)
+}
+
+TEST_CASE("byte_buffer allocates from a memory resource", "[byte_buffer]") {
+  std::array<std::byte, 8192> arena{};
+  std::pmr::monotonic_buffer_resource pool{
+      arena.data(), arena.size(), std::pmr::null_memory_resource()};
+  range3::pmr::basic_byte_buffer<1024> b{&pool};
+  b.resize(1000);
+  REQUIRE(address(b.data()) % 1024 == 0);
+  REQUIRE(b.data() >= arena.data());
+  REQUIRE(b.data() + b.size() <= arena.data() + arena.size());
+
+  range3::pmr::byte_buffer small{cbyte_view{"abc"sv}, &pool};
+  REQUIRE(small.get_allocator().resource() == &pool);
+  REQUIRE(range3::as_sv(cbyte_view{small}) == "abc");
+}
+
+TEST_CASE("growable_byte_writer appends to a byte_buffer", "[byte_buffer]") {
+  byte_buffer out;
+  range3::growable_byte_writer w{out};
+  w.write_be(std::uint16_t{0x0102});
+  auto cursor = w.reserve(4);
+  cursor.write_le(std::uint32_t{0x06050403});
+  w.write_bytes(cbyte_view{"!"sv});
+  REQUIRE(out.size() == 7);
+  REQUIRE(range3::as_sv(cbyte_view{out})
+          == "\x01\x02\x03\x04\x05\x06!"sv);
+  REQUIRE(address(out.data()) % 64 == 0);
+}
+
+// NOLINTEND(misc-const-correctness)
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_chain.hpp"
+#include "byte_span/byte_span.hpp"
+
+using range3::byte_chain;
+using range3::cbyte_view;
+using range3::npos;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+// Splits `text` into a chain of segments of the given sizes; the last one
+// takes the rest.
+auto chain_of(std::string_view text, std::vector<size_t> const& sizes)
+    -> byte_chain {
+  byte_chain chain;
+  for (auto const n : sizes) {
+    chain.append(cbyte_view{text.substr(0, n)});
+    text.remove_prefix(std::min(n, text.size()));
+  }
+  chain.append(cbyte_view{text});
+  return chain;
+}
+
+auto to_string(const byte_chain& chain) -> std::string {
+  std::string out;
+  for (auto const b : chain) {
+    out.push_back(static_cast<char>(b));
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("byte_chain appends and consumes segments", "[byte_chain]") {
+  STATIC_REQUIRE(std::random_access_iterator<byte_chain::iterator>);
+  STATIC_REQUIRE(std::ranges::random_access_range<byte_chain>);
+
+  byte_chain chain{cbyte_view{"hel"sv}, cbyte_view{""sv}, cbyte_view{"lo "sv}};
+  chain.append(cbyte_view{"world"sv});
+  REQUIRE(chain.size() == 11);
+  REQUIRE(chain.segment_count() == 3);  // the empty view is dropped
+  REQUIRE(to_string(chain) == "hello world");
+  REQUIRE(chain == cbyte_view{"hello world"sv});
+
+  std::vector<std::string_view> parts;
+  for (auto const s : chain.segments()) {
+    parts.push_back(range3::as_sv(s));
+  }
+  REQUIRE(parts == std::vector{"hel"sv, "lo "sv, "world"sv});
+
+  chain.consume(4);
+  REQUIRE(chain.size() == 7);
+  REQUIRE(chain.segment_count() == 2);
+  REQUIRE(to_string(chain) == "o world");
+  REQUIRE(chain[0] == std::byte{'o'});
+  REQUIRE(chain[6] == std::byte{'d'});
+
+  chain.consume(2);
+  REQUIRE(chain.segment_count() == 1);
+  REQUIRE(range3::as_sv(chain.begin().segment()) == "world");
+  chain.append(cbyte_view{"!"sv});
+  REQUIRE(chain[5] == std::byte{'!'});
+
+  chain.consume(chain.size());
+  REQUIRE(chain.empty());
+  REQUIRE(chain.segment_count() == 0);
+  REQUIRE(chain.begin() == chain.end());
+
+  chain.append(cbyte_view{"again"sv});
+  REQUIRE(to_string(chain) == "again");
+  chain.clear();
+  REQUIRE(chain.empty());
+}
+
+TEST_CASE("byte_chain iterators cross segments", "[byte_chain]") {
+  auto const text = "0123456789abcdef"sv;
+  auto chain = chain_of(text, {3, 1, 5});
+  chain.consume(1);
+  auto const rest = text.substr(1);
+
+  REQUIRE(std::ranges::distance(chain) == 15);
+  for (size_t i = 0; i < rest.size(); ++i) {
+    auto const it = chain.begin() + static_cast<std::ptrdiff_t>(i);
+    REQUIRE(it.offset() == i);
+    REQUIRE(*it == static_cast<std::byte>(rest[i]));
+    REQUIRE(chain[i] == static_cast<std::byte>(rest[i]));
+    REQUIRE(it - chain.begin() == static_cast<std::ptrdiff_t>(i));
+    REQUIRE(chain.end() - it == static_cast<std::ptrdiff_t>(rest.size() - i));
+  }
+
+  auto it = chain.end();
+  --it;
+  REQUIRE(*it == std::byte{'f'});
+  it -= 10;
+  REQUIRE(*it == std::byte{'5'});
+  REQUIRE(range3::as_sv(it.segment()) == "5678");
+  REQUIRE(it < chain.end());
+  REQUIRE(std::ranges::equal(
+      std::ranges::subrange(chain.begin(), chain.end()) | std::views::reverse,
+      cbyte_view{rest} | std::views::reverse));
+}
+
+TEST_CASE("byte_chain finds across segment boundaries", "[byte_chain]") {
+  auto const text = "GET / HTTP/1.1\r\nHost: x\r\n\r\nbody"sv;
+
+  for (size_t a = 1; a < text.size(); ++a) {
+    for (size_t b : {1U, 2U, 3U, 7U}) {
+      auto const chain = chain_of(text, {a, b, 1});
+      INFO("segments of " << a << ", " << b << ", 1");
+      REQUIRE(chain.find(std::byte{'\n'}) == text.find('\n'));
+      REQUIRE(chain.find(std::byte{'\n'}, 20) == text.find('\n', 20));
+      REQUIRE(chain.find(std::byte{'#'}) == npos);
+      for (auto const needle : {"\r\n\r\n"sv, "Host"sv, "body"sv, "x\r"sv,
+                                "HTTP/1.1\r\nHost"sv, "nope"sv, "\r\n"sv}) {
+        REQUIRE(chain.find(cbyte_view{needle}) == text.find(needle));
+        REQUIRE(chain.find(cbyte_view{needle}, 17) == text.find(needle, 17));
+      }
+    }
+  }
+
+  auto const chain = chain_of("abab"sv, {1, 1, 1});
+  REQUIRE(chain.find(cbyte_view{"bab"sv}) == 1);
+  REQUIRE(chain.find(cbyte_view{"ababa"sv}) == npos);
+  REQUIRE(chain.find(cbyte_view{""sv}, 2) == 2);
+  REQUIRE(byte_chain{}.find(std::byte{'a'}) == npos);
+}
+
+TEST_CASE("byte_chain compares across segment boundaries", "[byte_chain]") {
+  auto const chain = chain_of("message"sv, {2, 3});
+  auto const less = std::strong_ordering::less;
+  auto const equal = std::strong_ordering::equal;
+  auto const greater = std::strong_ordering::greater;
+  REQUIRE(chain.compare(cbyte_view{"message"sv}) == equal);
+  REQUIRE(chain.compare(cbyte_view{"messagf"sv}) == less);
+  REQUIRE(chain.compare(cbyte_view{"messag"sv}) == greater);
+  REQUIRE(chain.compare(cbyte_view{"message!"sv}) == less);
+  REQUIRE(chain.compare(cbyte_view{"mess"sv}) == greater);
+  REQUIRE(chain.compare(cbyte_view{"z"sv}) == less);
+  REQUIRE(chain.compare(1, 4, cbyte_view{"essa"sv}) == equal);
+  REQUIRE(chain.compare(4, 100, cbyte_view{"age"sv}) == equal);
+  REQUIRE(chain.starts_with(cbyte_view{"mes"sv}));
+  REQUIRE(chain.starts_with(cbyte_view{"sag"sv}, 3));
+  REQUIRE_FALSE(chain.starts_with(cbyte_view{"sage!"sv}, 3));
+  REQUIRE_FALSE(chain == cbyte_view{"messag"sv});
+}
+
+TEST_CASE("byte_chain linearizes only when it must", "[byte_chain]") {
+  auto const first = "header"sv;
+  auto const second = "-body"sv;
+  byte_chain chain{cbyte_view{first}, cbyte_view{second}};
+
+  auto const head = chain.linearize(4);
+  REQUIRE(head.data() == cbyte_view{first}.data());  // no copy
+  REQUIRE(range3::as_sv(head) == "head");
+  REQUIRE(chain.linearize(0).empty());
+
+  auto const joined = chain.linearize(9);
+  REQUIRE(joined.data() != cbyte_view{first}.data());
+  REQUIRE(range3::as_sv(joined) == "header-bo");
+
+  chain.consume(6);
+  REQUIRE(chain.linearize(5).data() == cbyte_view{second}.data());
+
+  std::string out(3, '\0');
+  REQUIRE(chain.copy_to(range3::byte_view{out}, 2) == 3);
+  REQUIRE(out == "ody");
+  REQUIRE(chain.copy_to(range3::byte_view{out}, 4) == 1);
+}
+
+// NOLINTEND(misc-const-correctness)
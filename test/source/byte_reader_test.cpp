@@ -0,0 +1,133 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <version>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_reader.hpp"
+#include "byte_span/byte_span.hpp"
+
+using range3::byte_errc;
+using range3::byte_span;
+using range3::cbyte_view;
+using range3::unchecked_byte_reader;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+struct point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+// magic "RB", version 1, big-endian length 5, payload "hello", trailer
+constexpr std::array<unsigned char, 12> message = {
+    'R', 'B', 0x01, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o', 0x34, 0x12};
+
+}  // namespace
+
+TEST_CASE("unchecked_byte_reader reads sequentially", "[byte_reader]") {
+  auto reader = unchecked_byte_reader{cbyte_view{message}};
+  REQUIRE(reader.remaining() == message.size());
+
+  auto const magic = reader.read_bytes<2>();
+  STATIC_REQUIRE(decltype(magic)::extent == 2);
+  REQUIRE(range3::as_sv(magic) == "RB");
+  REQUIRE(reader.read<std::uint8_t>() == 1);
+  REQUIRE(reader.peek<std::uint8_t>() == 0);
+  auto const length = reader.read_be<std::uint16_t>();
+  REQUIRE(length == 5);
+
+  auto const payload = reader.read_bytes(length);
+  REQUIRE(range3::as_sv(payload) == "hello");
+  REQUIRE(payload.data() == cbyte_view{message}.data() + 5);
+
+  REQUIRE(reader.position() == 10);
+  REQUIRE(reader.read_le<std::uint16_t>() == 0x1234);
+  REQUIRE(reader.empty());
+  REQUIRE(reader.rest().empty());
+}
+
+TEST_CASE("unchecked_byte_reader reads trivially copyable values",
+          "[byte_reader]") {
+  auto const p = point{-3, 7};
+  auto reader = unchecked_byte_reader{byte_span{&p, 1}};
+  auto const copy = reader.read<point>();
+  REQUIRE(copy.x == -3);
+  REQUIRE(copy.y == 7);
+}
+
+using range3::byte_reader;
+
+TEST_CASE("byte_reader reports short input without consuming",
+          "[byte_reader]") {
+  auto reader = byte_reader{cbyte_view{message}};
+
+  REQUIRE(reader.skip(3).has_value());
+  auto const length = reader.read_be<std::uint16_t>();
+  REQUIRE(length.has_value());
+  REQUIRE(*length == 5);
+
+  auto const too_long = reader.read_bytes(8);
+  REQUIRE_FALSE(too_long.has_value());
+  REQUIRE(too_long.error() == byte_errc::out_of_range);
+  REQUIRE(reader.position() == 5);
+
+  auto const payload = reader.read_bytes(*length);
+  REQUIRE(payload.has_value());
+  REQUIRE(range3::as_sv(*payload) == "hello");
+
+  REQUIRE_FALSE(reader.read<std::uint32_t>().has_value());
+  REQUIRE(reader.peek<std::uint16_t>().value() == 0x1234);
+  REQUIRE(reader.read_le<std::uint16_t>().value() == 0x1234);
+  REQUIRE(reader.empty());
+  REQUIRE(reader.read<std::uint8_t>().error() == byte_errc::out_of_range);
+  REQUIRE(reader.skip(1).error() == byte_errc::out_of_range);
+  REQUIRE(reader.skip(0).has_value());
+}
+
+TEST_CASE("byte_reader reserve checks once for a batch of reads",
+          "[byte_reader]") {
+  auto reader = byte_reader{cbyte_view{message}};
+
+  auto header = reader.reserve(5);
+  REQUIRE(header.has_value());
+  REQUIRE(reader.position() == 5);
+  REQUIRE(header->read_bytes<2>().size() == 2);
+  REQUIRE(header->read<std::uint8_t>() == 1);
+  REQUIRE(header->read_be<std::uint16_t>() == 5);
+  REQUIRE(header->empty());
+
+  REQUIRE(reader.reserve(8).error() == byte_errc::out_of_range);
+  REQUIRE(reader.remaining() == 7);
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202211L
+  SECTION("monadic composition") {
+    auto const read_trailer = [&] { return reader.read_le<std::uint16_t>(); };
+    auto const sum = reader.skip(5).and_then(read_trailer).transform(
+        [](std::uint16_t v) { return v + 1; });
+    REQUIRE(sum.value() == 0x1235);
+  }
+#endif
+}
+
+TEST_CASE("byte_reader works in constant expressions", "[byte_reader]") {
+  STATIC_REQUIRE([] {
+    constexpr std::array<std::byte, 5> header{
+        std::byte{'R'}, std::byte{'B'}, std::byte{1}, std::byte{0},
+        std::byte{5}};
+    auto reader = byte_reader{cbyte_view{header}};
+    auto const skipped = reader.skip(2);
+    auto const version = reader.read<std::uint8_t>();
+    auto const too_long = reader.read_bytes(10);
+    return skipped.has_value() && version.value() == 1 && !too_long
+        && too_long.error() == byte_errc::out_of_range
+        && reader.read_be<std::uint16_t>().value() == 5;
+  }());
+}
+
+// NOLINTEND(misc-const-correctness)
@@ -65,6 +65,15 @@ TEMPLATE_TEST_CASE("const_convertible cross-type checks - should pass",
   STATIC_REQUIRE(const_convertible<const from, const to&>);
 }
 
+TEST_CASE("byte_span is as small as a pointer and size", "[byte_span]") {
+  // Static extents keep no size member.
+  STATIC_REQUIRE(sizeof(byte_span<std::byte, 16>) == sizeof(void*));
+  STATIC_REQUIRE(sizeof(byte_span<const std::byte, 4096>) == sizeof(void*));
+  STATIC_REQUIRE(sizeof(byte_span<const std::byte>) == 2 * sizeof(void*));
+  STATIC_REQUIRE(std::is_trivially_copyable_v<byte_span<std::byte>>);
+  STATIC_REQUIRE(std::is_trivially_copyable_v<byte_span<std::byte, 8>>);
+}
+
 TEST_CASE("byte_span default constructor", "[byte_span]") {
   STATIC_REQUIRE(std::is_default_constructible_v<byte_span<std::byte>>);
   STATIC_REQUIRE(std::is_default_constructible_v<byte_span<const std::byte>>);
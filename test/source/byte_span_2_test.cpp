@@ -161,6 +161,21 @@ TEST_CASE("byte_span from std::span - static extent specializations",
   }
 }
 
+TEST_CASE("byte_span sub-views of a static extent", "[byte_span]") {
+  std::array<std::byte, 16> arr{};
+  byte_span<std::byte, 16> bs{arr};
+
+  auto tail = bs.subspan<4>();
+  STATIC_REQUIRE(std::is_same_v<decltype(tail), byte_span<std::byte, 12>>);
+  REQUIRE(tail.data() == arr.data() + 4);
+
+  auto head = bs.first(3);
+  STATIC_REQUIRE(std::is_same_v<decltype(head), byte_view>);
+  REQUIRE(head.size() == 3);
+  REQUIRE(bs.last(5).size() == 5);
+  REQUIRE(bs.subspan(2, 6).size() == 6);
+}
+
 TEST_CASE("byte_span construction from other byte_span", "[byte_span]") {
   std::vector<char> vec{1, 2, 3};
   const byte_span<std::byte> original{std::span{vec}};
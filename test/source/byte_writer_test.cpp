@@ -0,0 +1,113 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <version>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/byte_writer.hpp"
+#include "byte_span/endian.hpp"
+
+using range3::byte_errc;
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::growable_byte_writer;
+using range3::unchecked_byte_writer;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+TEST_CASE("unchecked_byte_writer encodes sequentially", "[byte_writer]") {
+  std::array<std::byte, 12> buffer{};
+  auto writer = unchecked_byte_writer{buffer};
+
+  writer.write_bytes(cbyte_view{"RB"sv});
+  writer.write(std::uint8_t{1});
+  writer.write_be(std::uint16_t{5});
+  writer.write_bytes(cbyte_view{"hello"sv});
+  writer.write_le(std::uint16_t{0x1234});
+
+  REQUIRE(writer.remaining() == 0);
+  REQUIRE(writer.position() == buffer.size());
+  REQUIRE(range3::as_sv(writer.written()) == "RB\x01\x00\x05hello\x34\x12"sv);
+}
+
+TEST_CASE("unchecked_byte_writer can back-fill a skipped field",
+          "[byte_writer]") {
+  std::array<std::byte, 8> buffer{};
+  auto writer = unchecked_byte_writer{buffer};
+  auto length_field = writer.reserve(2);
+  writer.write_bytes(cbyte_view{"abc"sv});
+  length_field.write_be(static_cast<std::uint16_t>(writer.position() - 2));
+
+  REQUIRE(range3::load_be<std::uint16_t>(byte_view{buffer}) == 3);
+  REQUIRE(writer.written().size() == 5);
+}
+
+using range3::byte_writer;
+
+TEST_CASE("byte_writer reports overflow instead of writing past the end",
+          "[byte_writer]") {
+  std::array<std::byte, 6> buffer{};
+  auto writer = byte_writer{buffer};
+
+  REQUIRE(writer.write_be(std::uint32_t{0xDEADBEEF}).has_value());
+  auto const overflow = writer.write_le(std::uint32_t{1});
+  REQUIRE_FALSE(overflow.has_value());
+  REQUIRE(overflow.error() == byte_errc::out_of_range);
+  REQUIRE(writer.position() == 4);
+
+  REQUIRE(writer.write_bytes(cbyte_view{"xyz"sv}).error()
+          == byte_errc::out_of_range);
+  REQUIRE(writer.write(std::uint16_t{7}).has_value());
+  REQUIRE(writer.remaining() == 0);
+  REQUIRE(writer.write(std::uint8_t{0}).error() == byte_errc::out_of_range);
+  REQUIRE(writer.skip(1).error() == byte_errc::out_of_range);
+  REQUIRE(buffer[0] == std::byte{0xDE});
+}
+
+TEST_CASE("byte_writer reserve checks once for a batch of writes",
+          "[byte_writer]") {
+  std::array<std::byte, 10> buffer{};
+  auto writer = byte_writer{buffer};
+
+  auto record = writer.reserve(8);
+  REQUIRE(record.has_value());
+  record->write_be(std::uint32_t{1});
+  record->write_be(std::uint32_t{2});
+  REQUIRE(writer.position() == 8);
+  REQUIRE(range3::load_be<std::uint32_t>(byte_view{buffer}, 4) == 2);
+
+  REQUIRE(writer.reserve(3).error() == byte_errc::out_of_range);
+  REQUIRE(writer.reserve(2).has_value());
+}
+
+TEST_CASE("growable_byte_writer appends to a container", "[byte_writer]") {
+  SECTION("std::vector<std::byte>") {
+    auto out = std::vector<std::byte>{};
+    auto writer = growable_byte_writer{out};
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+      writer.write_le(i);
+    }
+    writer.write_bytes(cbyte_view{"end"sv});
+    REQUIRE(out.size() == 4003);
+    REQUIRE(range3::load_le<std::uint32_t>(byte_view{out}, 4 * 999) == 999);
+    REQUIRE(range3::as_sv(writer.written().last(3)) == "end");
+  }
+
+  SECTION("std::string with a reserved block") {
+    auto out = std::string{"id:"};
+    auto writer = growable_byte_writer<std::string>{out};
+    auto block = writer.reserve(4);
+    block.write_be(std::uint32_t{0x41424344});
+    writer.write(std::uint8_t{'!'});
+    REQUIRE(out == "id:ABCD!");
+    REQUIRE(writer.position() == out.size());
+  }
+}
+
+// NOLINTEND(misc-const-correctness)
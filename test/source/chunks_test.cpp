@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/chunks.hpp"
+
+using range3::byte_span;
+using range3::byte_view;
+using range3::cbyte_view;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+// A function that only accepts a fixed-size block
+auto block_sum(byte_span<const std::byte, 4> block) -> unsigned {
+  unsigned sum = 0;
+  for (auto const b : block) {
+    sum += std::to_integer<unsigned>(b);
+  }
+  return sum;
+}
+
+}  // namespace
+
+TEST_CASE("chunks is a random-access range of static blocks", "[chunks]") {
+  using view = range3::chunk_view<const std::byte, 64>;
+  STATIC_REQUIRE(std::ranges::random_access_range<view>);
+  STATIC_REQUIRE(std::ranges::sized_range<view>);
+  STATIC_REQUIRE(std::ranges::common_range<view>);
+  STATIC_REQUIRE(std::ranges::view<view>);
+  STATIC_REQUIRE(std::ranges::borrowed_range<view>);
+  STATIC_REQUIRE(std::is_same_v<std::ranges::range_reference_t<view>,
+                                byte_span<const std::byte, 64>>);
+  STATIC_REQUIRE(std::is_same_v<decltype(std::declval<view>().tail()),
+                                cbyte_view>);
+}
+
+TEST_CASE("chunks splits into full blocks and a tail", "[chunks]") {
+  auto const text = "abcdefghij"sv;
+  auto const bytes = cbyte_view{text};
+  auto const blocks = range3::chunks<4>(cbyte_view{text});
+  REQUIRE(blocks.size() == 2);
+  REQUIRE(range3::as_sv(blocks[0]) == "abcd");
+  REQUIRE(range3::as_sv(blocks[1]) == "efgh");
+  REQUIRE(range3::as_sv(blocks.tail()) == "ij");
+  REQUIRE(blocks.back().data() == bytes.data() + 4);
+
+  std::vector<unsigned> sums;
+  for (auto const block : blocks) {
+    sums.push_back(block_sum(block));
+  }
+  REQUIRE(sums == std::vector<unsigned>{'a' + 'b' + 'c' + 'd',
+                                        'e' + 'f' + 'g' + 'h'});
+
+  auto const exact = range3::chunks<5>(cbyte_view{text});
+  REQUIRE(exact.size() == 2);
+  REQUIRE(exact.tail().empty());
+  REQUIRE(exact.tail().data() == bytes.data() + bytes.size());
+
+  auto const short_input = range3::chunks<16>(cbyte_view{text});
+  REQUIRE(short_input.empty());
+  REQUIRE(short_input.begin() == short_input.end());
+  REQUIRE(range3::as_sv(short_input.tail()) == text);
+
+  REQUIRE(range3::chunks<8>(cbyte_view{}).empty());
+  REQUIRE(range3::chunks<8>(cbyte_view{}).tail().empty());
+}
+
+TEST_CASE("chunks iterators support random access", "[chunks]") {
+  std::vector<std::byte> data(4096 + 100);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>(i / 64);
+  }
+  auto const blocks = range3::chunks<64>(byte_view{data});
+  REQUIRE(blocks.size() == 65);
+  REQUIRE(blocks.tail().size() == 36);
+
+  auto it = blocks.begin();
+  it += 10;
+  REQUIRE((*it)[0] == std::byte{10});
+  REQUIRE(it[5][63] == std::byte{15});
+  REQUIRE(blocks.end() - it == 55);
+  REQUIRE(it - blocks.begin() == 10);
+  REQUIRE(--it < blocks.begin() + 10);
+  REQUIRE((*(blocks.end() - 1)).size() == 64);
+
+  // Disjoint halves, as a parallel loop would hand out.
+  auto const mid = blocks.begin() + std::ranges::ssize(blocks) / 2;
+  auto const count = [](auto first, auto last) {
+    return std::count_if(first, last, [](auto block) {
+      return block.front() == block.back();
+    });
+  };
+  REQUIRE(count(blocks.begin(), mid) + count(mid, blocks.end()) == 65);
+
+  // Writable blocks write through to the buffer.
+  for (auto block : blocks | std::views::reverse) {
+    block[0] = std::byte{0xFF};
+  }
+  REQUIRE(data[64 * 64] == std::byte{0xFF});
+  REQUIRE(data[(64 * 64) + 1] == std::byte{64});
+}
+
+TEST_CASE("chunks of a static extent", "[chunks]") {
+  std::array<std::uint32_t, 5> words{};
+  auto const blocks = range3::chunks<8>(byte_span{words});
+  REQUIRE(blocks.size() == 2);
+  REQUIRE(blocks.tail().size() == 4);
+  STATIC_REQUIRE(decltype(blocks.front())::extent == 8);
+}
+
+TEST_CASE("chunks in constant expressions", "[chunks]") {
+  STATIC_REQUIRE([] {
+    std::array<std::byte, 10> data{};
+    std::ranges::fill(data, std::byte{1});
+    auto const blocks = range3::chunks<3>(byte_view{data});
+    unsigned sum = 0;
+    for (auto const block : blocks) {
+      sum += std::to_integer<unsigned>(block[0] | block[2]);
+    }
+    return sum * 10 + static_cast<unsigned>(blocks.tail().size());
+  }() == 31);
+}
+
+// NOLINTEND(misc-const-correctness)
@@ -0,0 +1,128 @@
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/compare.hpp"
+
+using range3::byte_span;
+using range3::byte_view;
+using range3::cbyte_view;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto memcmp_order(cbyte_view a, cbyte_view b) -> std::strong_ordering {
+  auto const n = std::min(a.size(), b.size());
+  auto const r = n == 0 ? 0 : std::memcmp(a.data(), b.data(), n);
+  if (r != 0) {
+    return r < 0 ? std::strong_ordering::less : std::strong_ordering::greater;
+  }
+  return a.size() <=> b.size();
+}
+
+}  // namespace
+
+TEST_CASE("equal, mismatch and compare on dynamic extents", "[compare]") {
+  auto const abc = cbyte_view{"abc"sv};
+  auto const abd = cbyte_view{"abd"sv};
+  auto const ab = cbyte_view{"ab"sv};
+
+  REQUIRE(range3::equal(abc, cbyte_view{"abc"sv}));
+  REQUIRE_FALSE(range3::equal(abc, abd));
+  REQUIRE_FALSE(range3::equal(abc, ab));
+  REQUIRE(range3::equal(cbyte_view{}, cbyte_view{}));
+
+  REQUIRE(range3::mismatch(abc, abd) == 2);
+  REQUIRE(range3::mismatch(abc, ab) == 2);
+  REQUIRE(range3::mismatch(abc, abc) == 3);
+
+  REQUIRE(range3::compare(abc, abd) == std::strong_ordering::less);
+  REQUIRE(range3::compare(abd, abc) == std::strong_ordering::greater);
+  REQUIRE(range3::compare(ab, abc) == std::strong_ordering::less);
+  REQUIRE(range3::compare(abc, abc) == std::strong_ordering::equal);
+
+  SECTION("bytes compare as unsigned values") {
+    std::array<unsigned char, 1> high = {0x80};
+    std::array<unsigned char, 1> low = {0x7F};
+    REQUIRE(range3::compare(cbyte_view{high}, cbyte_view{low})
+            == std::strong_ordering::greater);
+  }
+
+  SECTION("operators") {
+    REQUIRE(abc == cbyte_view{"abc"sv});
+    REQUIRE(abc != abd);
+    REQUIRE(abc < abd);
+    REQUIRE(ab < abc);
+    REQUIRE(abd >= abc);
+  }
+}
+
+TEST_CASE("mismatch agrees with a scalar reference", "[compare]") {
+  for (size_t size : {1U, 15U, 16U, 17U, 31U, 32U, 33U, 64U, 65U, 200U}) {
+    auto a = std::vector<std::byte>(size, std::byte{0x5A});
+    auto const b = a;
+    REQUIRE(range3::mismatch(a, b) == size);
+    REQUIRE(range3::equal(a, b));
+    for (size_t i = 0; i < size; ++i) {
+      a[i] = std::byte{0x5B};
+      REQUIRE(range3::mismatch(a, b) == i);
+      REQUIRE_FALSE(range3::equal(a, b));
+      REQUIRE(range3::compare(a, b) == memcmp_order(a, b));
+      REQUIRE(range3::compare(b, a) == memcmp_order(b, a));
+      a[i] = std::byte{0x5A};
+    }
+  }
+}
+
+TEST_CASE("static extents use the unrolled comparison", "[compare]") {
+  std::array<std::byte, 16> key1{};
+  std::array<std::byte, 16> key2{};
+  std::array<std::byte, 32> key3{};
+  std::array<std::byte, 13> key4{};
+  std::array<std::byte, 13> key5{};
+
+  auto const k1 = byte_span{key1};
+  auto const k2 = byte_span{key2};
+  STATIC_REQUIRE(decltype(k1)::extent == 16);
+
+  REQUIRE(k1 == k2);
+  REQUIRE((k1 <=> k2) == std::strong_ordering::equal);
+  REQUIRE_FALSE(byte_span{key1} == byte_span{key3});
+  REQUIRE(byte_span{key1} < byte_span{key3});
+
+  for (size_t i = 0; i < key1.size(); ++i) {
+    key1[i] = std::byte{1};
+    REQUIRE(k1 != k2);
+    REQUIRE(k1 > k2);
+    REQUIRE(k2 < k1);
+    REQUIRE((k1 <=> k2) == memcmp_order(k1, k2));
+    key2[i] = std::byte{2};
+    REQUIRE(k1 < k2);
+    REQUIRE((k1 <=> k2) == memcmp_order(k1, k2));
+    key1[i] = key2[i] = std::byte{0};
+  }
+
+  for (size_t i = 0; i < key4.size(); ++i) {
+    key4[i] = std::byte{0xFF};
+    REQUIRE(byte_span{key4} != byte_span{key5});
+    REQUIRE(byte_span{key4} > byte_span{key5});
+    key4[i] = std::byte{0};
+  }
+
+  SECTION("mixed const, extent and element types") {
+    std::vector<char> dynamic(16);
+    REQUIRE(byte_span{dynamic} == k1);
+    REQUIRE(k1 == cbyte_view{dynamic});
+    REQUIRE((cbyte_view{dynamic} <=> k1) == std::strong_ordering::equal);
+  }
+}
+
+// NOLINTEND(misc-const-correctness)
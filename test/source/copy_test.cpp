@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/copy.hpp"
+
+using range3::byte_view;
+using range3::cbyte_view;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+TEST_CASE("copy streams at any alignment and length", "[copy]") {
+  std::vector<std::byte> source(1024 + 64);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source[i] = static_cast<std::byte>((i * 13) + 5);
+  }
+  for (size_t const threshold :
+       {size_t{0}, range3::default_streaming_threshold}) {
+    for (size_t from = 0; from < 5; ++from) {
+      for (size_t to = 0; to < 70; to += 3) {
+        for (size_t n : {0U, 1U, 15U, 16U, 17U, 63U, 64U, 65U, 200U, 1024U}) {
+          INFO("threshold " << threshold << ", " << n << " bytes from +"
+                            << from << " to +" << to);
+          std::vector<std::byte> target(n + 128, std::byte{0xEE});
+          auto const src = cbyte_view{source}.subspan(from, n);
+          auto const dst = byte_view{target}.subspan(to);
+          REQUIRE(range3::copy(src, dst, threshold) == n);
+          REQUIRE(std::ranges::equal(src, dst.first(n)));
+          REQUIRE(std::ranges::all_of(
+              byte_view{target}.first(to),
+              [](std::byte b) { return b == std::byte{0xEE}; }));
+          REQUIRE(std::ranges::all_of(
+              dst.subspan(n),
+              [](std::byte b) { return b == std::byte{0xEE}; }));
+        }
+      }
+    }
+  }
+
+  // The shorter view bounds the copy.
+  std::array<std::byte, 4> small{};
+  REQUIRE(range3::copy(cbyte_view{source}, byte_view{small}, 0) == 4);
+  REQUIRE(small[3] == source[3]);
+}
+
+TEST_CASE("fill streams at any alignment and length", "[copy]") {
+  std::vector<std::byte> buffer(1024 + 128);
+  for (size_t const threshold :
+       {size_t{0}, range3::default_streaming_threshold}) {
+    for (size_t to = 0; to < 70; to += 3) {
+      for (size_t n : {0U, 1U, 31U, 32U, 33U, 127U, 128U, 129U, 1024U}) {
+        INFO("threshold " << threshold << ", " << n << " bytes at +" << to);
+        std::ranges::fill(buffer, std::byte{0xEE});
+        auto const bytes = byte_view{buffer}.subspan(to, n);
+        range3::fill(bytes, std::byte{0x5A}, threshold);
+        size_t wrong = 0;
+        for (size_t i = 0; i < buffer.size(); ++i) {
+          auto const inside = i >= to && i < to + n;
+          wrong += buffer[i] != (inside ? std::byte{0x5A} : std::byte{0xEE})
+                     ? 1U
+                     : 0U;
+        }
+        REQUIRE(wrong == 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("secure_zero clears the view", "[copy]") {
+  std::array<std::byte, 37> key{};
+  std::ranges::fill(key, std::byte{0xA5});
+  range3::secure_zero(byte_view{key}.subspan(1, 35));
+  REQUIRE(key.front() == std::byte{0xA5});
+  REQUIRE(key.back() == std::byte{0xA5});
+  REQUIRE(std::ranges::all_of(byte_view{key}.subspan(1, 35),
+                              [](std::byte b) { return b == std::byte{0}; }));
+  range3::secure_zero(byte_view{});
+}
+
+TEST_CASE("copy and fill in constant expressions", "[copy]") {
+  STATIC_REQUIRE([] {
+    std::array<std::byte, 8> a{};
+    std::array<std::byte, 6> b{};
+    range3::fill(byte_view{a}, std::byte{7});
+    auto const n = range3::copy(cbyte_view{a}, byte_view{b});
+    return n == 6 && b[5] == std::byte{7};
+  }());
+}
+
+// NOLINTEND(misc-const-correctness)
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/crc32c.hpp"
+
+using range3::cbyte_view;
+using range3::crc32c;
+using range3::crc32c_combine;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+// Bitwise reference implementation.
+auto reference_crc32c(cbyte_view bytes) -> std::uint32_t {
+  std::uint32_t crc = ~0U;
+  for (auto b : bytes) {
+    crc ^= std::to_integer<std::uint32_t>(b);
+    for (int k = 0; k < 8; ++k) {
+      crc = (crc & 1U) != 0 ? (crc >> 1U) ^ 0x82F63B78U : crc >> 1U;
+    }
+  }
+  return ~crc;
+}
+
+auto make_input(size_t size) -> std::vector<std::byte> {
+  auto v = std::vector<std::byte>(size);
+  std::uint32_t x = 0x12345678U;
+  for (auto& b : v) {
+    x = x * 1664525U + 1013904223U;
+    b = std::byte{static_cast<unsigned char>(x >> 24U)};
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST_CASE("crc32c known answers", "[crc32c]") {
+  REQUIRE(crc32c(cbyte_view{}) == 0);
+  REQUIRE(crc32c(cbyte_view{"123456789"sv}) == 0xE3069283U);
+
+  // RFC 3720, appendix B.4
+  std::array<unsigned char, 32> data{};
+  REQUIRE(crc32c(data) == 0x8A9136AAU);
+  data.fill(0xFF);
+  REQUIRE(crc32c(data) == 0x62A8AB43U);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<unsigned char>(i);
+  }
+  REQUIRE(crc32c(data) == 0x46DD794EU);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<unsigned char>(31 - i);
+  }
+  REQUIRE(crc32c(data) == 0x113FDB5CU);
+}
+
+TEST_CASE("crc32c matches a bitwise reference across kernel boundaries",
+          "[crc32c]") {
+  auto const data = make_input(3 * 8192 + 3 * 256 + 77);
+  auto const view = cbyte_view{data};
+  for (size_t len : {0U,
+                     1U,
+                     7U,
+                     8U,
+                     9U,
+                     767U,
+                     768U,
+                     769U,
+                     1000U,
+                     3U * 8192U,
+                     3U * 8192U + 3U * 256U + 77U}) {
+    REQUIRE(crc32c(view.first(len)) == reference_crc32c(view.first(len)));
+  }
+}
+
+TEST_CASE("crc32c is incremental and combinable", "[crc32c]") {
+  auto const data = make_input(30000);
+  auto const view = cbyte_view{data};
+  auto const whole = crc32c(view);
+
+  for (size_t split : {0U, 1U, 100U, 768U, 24576U, 29999U, 30000U}) {
+    auto const head = view.first(split);
+    auto const tail = view.subspan(split);
+    REQUIRE(crc32c(tail, crc32c(head)) == whole);
+    REQUIRE(crc32c_combine(crc32c(head), crc32c(tail), tail.size()) == whole);
+  }
+
+  SECTION("combining many subspans") {
+    std::uint32_t crc = 0;
+    for (size_t off = 0; off < view.size(); off += 1234) {
+      auto const part =
+          view.subspan(off, std::min<size_t>(1234, view.size() - off));
+      crc = crc32c_combine(crc, crc32c(part), part.size());
+    }
+    REQUIRE(crc == whole);
+  }
+}
+
+// NOLINTEND(misc-const-correctness)
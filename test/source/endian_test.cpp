@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/endian.hpp"
+
+using range3::byte_span;
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::load_be;
+using range3::load_le;
+using range3::store_be;
+using range3::store_le;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+enum class opcode : std::uint16_t { ping = 0x0102, pong = 0x0A0B };
+
+template <typename T, size_t Offset, typename Span>
+concept static_loadable = requires(Span s) { load_le<T, Offset>(s); };
+
+template <typename Span>
+concept storable = requires(Span s) { store_le(s, std::uint32_t{1}); };
+
+// Checks byteswap_inplace and byteswap_copy byte by byte, at every
+// misalignment and for lengths that are not a multiple of
+// sizeof(T).
+template <typename T>
+void check_byteswap() {
+  std::vector<std::byte> source(300 + 8);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source[i] = static_cast<std::byte>((i * 7) + 1);
+  }
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t n = 0; n <= 300; n += n < 40 ? 1 : 37) {
+      INFO("sizeof(T) = " << sizeof(T) << ", offset " << offset << ", " << n
+                          << " bytes");
+      auto const in = cbyte_view{source}.subspan(offset, n);
+      auto const count = n / sizeof(T);
+
+      std::vector<std::byte> buffer(source);
+      auto const inplace = byte_view{buffer}.subspan(offset, n);
+      REQUIRE(range3::byteswap_inplace<T>(inplace) == count);
+
+      std::vector<std::byte> copied(n + 1, std::byte{0xEE});
+      REQUIRE(range3::byteswap_copy<T>(in, byte_view{copied}) == count);
+
+      size_t mismatches = 0;
+      for (size_t i = 0; i < count * sizeof(T); ++i) {
+        auto const from = (i / sizeof(T) * sizeof(T)) + sizeof(T) - 1
+                        - (i % sizeof(T));
+        mismatches += inplace[i] != in[from] ? 1U : 0U;
+        mismatches += copied[i] != in[from] ? 1U : 0U;
+      }
+      REQUIRE(mismatches == 0);
+      // Trailing bytes and everything around the view are untouched.
+      REQUIRE(std::equal(in.begin() + static_cast<std::ptrdiff_t>(
+                                          count * sizeof(T)),
+                         in.end(),
+                         inplace.begin() + static_cast<std::ptrdiff_t>(
+                                               count * sizeof(T))));
+      REQUIRE(std::equal(source.begin(),
+                         source.begin() + static_cast<std::ptrdiff_t>(offset),
+                         buffer.begin()));
+      REQUIRE(copied[count * sizeof(T)] == std::byte{0xEE});
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("load_le and load_be on dynamic extents", "[endian]") {
+  std::array<unsigned char, 11> wire = {
+      0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A};
+  auto const bytes = cbyte_view{wire};
+
+  REQUIRE(load_le<std::uint8_t>(bytes) == 0xFF);
+  REQUIRE(load_le<std::uint16_t>(bytes, 1) == 0x0201);
+  REQUIRE(load_be<std::uint16_t>(bytes, 1) == 0x0102);
+  REQUIRE(load_le<std::uint32_t>(bytes, 1) == 0x04030201U);
+  REQUIRE(load_be<std::uint32_t>(bytes, 1) == 0x01020304U);
+  REQUIRE(load_le<std::uint64_t>(bytes, 3) == 0x0A09080706050403ULL);
+  REQUIRE(load_be<std::uint64_t>(bytes, 3) == 0x030405060708090AULL);
+  REQUIRE(load_le<std::int8_t>(bytes) == -1);
+  REQUIRE(load_be<std::int16_t>(bytes) == static_cast<std::int16_t>(0xFF01));
+  REQUIRE(load_be<opcode>(bytes, 1) == opcode::ping);
+}
+
+TEST_CASE("store_le and store_be round-trip", "[endian]") {
+  std::vector<std::byte> buffer(16);
+  auto const bytes = byte_view{buffer};
+
+  store_be(bytes, std::uint32_t{0x01020304U}, 1);
+  REQUIRE(buffer[1] == std::byte{0x01});
+  REQUIRE(buffer[4] == std::byte{0x04});
+  REQUIRE(load_be<std::uint32_t>(bytes, 1) == 0x01020304U);
+
+  store_le<std::uint16_t>(bytes, 0xBEEF, 5);
+  REQUIRE(buffer[5] == std::byte{0xEF});
+  REQUIRE(buffer[6] == std::byte{0xBE});
+
+  store_le(bytes, -2.5, 8);
+  REQUIRE(std::bit_cast<std::uint64_t>(load_le<double>(bytes, 8))
+          == std::bit_cast<std::uint64_t>(-2.5));
+  store_be(bytes, 1.5F, 0);
+  REQUIRE(buffer[0] == std::byte{0x3F});
+  REQUIRE(std::bit_cast<std::uint32_t>(load_be<float>(bytes)) == 0x3FC00000U);
+
+  store_be(bytes, opcode::pong, 14);
+  REQUIRE(load_be<opcode>(bytes, 14) == opcode::pong);
+  REQUIRE(load_le<std::uint16_t>(bytes, 14) == 0x0B0A);
+
+  STATIC_REQUIRE(storable<byte_view>);
+  STATIC_REQUIRE_FALSE(storable<cbyte_view>);
+}
+
+TEST_CASE("static offsets on static extents", "[endian]") {
+  std::array<std::byte, 8> header{};
+  auto const bytes = byte_span{header};
+
+  store_be<std::uint16_t, 0>(bytes, 0xCAFE);
+  store_le<std::uint32_t, 2>(bytes, 0x11223344U);
+  store_be<std::uint16_t, 6>(bytes, 7);
+
+  REQUIRE(load_be<std::uint16_t, 0>(bytes) == 0xCAFE);
+  REQUIRE(load_le<std::uint32_t, 2>(bytes) == 0x11223344U);
+  REQUIRE(load_be<std::uint32_t, 2>(bytes) == 0x44332211U);
+  REQUIRE(load_be<std::uint16_t, 6>(bytes) == 7);
+  REQUIRE(load_le<std::uint64_t, 0>(bytes)
+          == load_le<std::uint64_t>(cbyte_view{bytes}));
+
+  STATIC_REQUIRE(static_loadable<std::uint32_t, 4, decltype(bytes)>);
+  STATIC_REQUIRE_FALSE(static_loadable<std::uint32_t, 5, decltype(bytes)>);
+  STATIC_REQUIRE_FALSE(static_loadable<std::uint64_t, 1, decltype(bytes)>);
+  STATIC_REQUIRE_FALSE(static_loadable<std::uint32_t, 0, cbyte_view>);
+}
+
+TEST_CASE("byteswap arrays of any alignment and length", "[endian]") {
+  check_byteswap<std::uint16_t>();
+  check_byteswap<std::uint32_t>();
+  check_byteswap<std::uint64_t>();
+  check_byteswap<std::int32_t>();
+  check_byteswap<float>();
+  check_byteswap<double>();
+  check_byteswap<opcode>();
+}
+
+TEST_CASE("byteswap converts big-endian arrays", "[endian]") {
+  std::array<std::uint8_t, 7> wire{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+  std::array<std::uint16_t, 3> values{};
+  REQUIRE(range3::byteswap_copy<std::uint16_t>(cbyte_view{wire},
+                                               byte_view{values})
+          == 3);
+  if constexpr (std::endian::native == std::endian::little) {
+    REQUIRE(values == std::array<std::uint16_t, 3>{0x0102, 0x0304, 0x0506});
+  }
+  REQUIRE(range3::byteswap_inplace<std::uint8_t>(byte_view{wire}) == 7);
+  REQUIRE(wire[0] == 0x01);
+
+  // A shorter output limits the count.
+  REQUIRE(range3::byteswap_copy<std::uint32_t>(
+              cbyte_view{wire}, byte_view{values}.first(3))
+          == 0);
+  REQUIRE(range3::byteswap_inplace<std::uint64_t>(byte_view{}) == 0);
+
+  STATIC_REQUIRE([] {
+    std::array<std::byte, 9> data{std::byte{1}, std::byte{2}, std::byte{3},
+                                  std::byte{4}, std::byte{5}, std::byte{6},
+                                  std::byte{7}, std::byte{8}, std::byte{9}};
+    auto const n = range3::byteswap_inplace<std::uint32_t>(byte_view{data});
+    return n == 2 && data[0] == std::byte{4} && data[3] == std::byte{1}
+        && data[4] == std::byte{8} && data[8] == std::byte{9};
+  }());
+}
+
+// NOLINTEND(misc-const-correctness)
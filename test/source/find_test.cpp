@@ -0,0 +1,197 @@
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/find.hpp"
+
+using range3::byte_span;
+using range3::cbyte_view;
+using range3::npos;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto naive_find_if(cbyte_view bytes, size_t pos, auto pred) -> size_t {
+  for (size_t i = pos; i < bytes.size(); ++i) {
+    if (pred(bytes[i])) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+auto naive_find_last_if(cbyte_view bytes, size_t pos, auto pred) -> size_t {
+  if (bytes.empty()) {
+    return npos;
+  }
+  for (size_t i = std::min(pos, bytes.size() - 1) + 1; i != 0; --i) {
+    if (pred(bytes[i - 1])) {
+      return i - 1;
+    }
+  }
+  return npos;
+}
+
+auto make_pattern(size_t size) -> std::vector<std::byte> {
+  auto v = std::vector<std::byte>(size);
+  for (size_t i = 0; i < size; ++i) {
+    v[i] = std::byte{static_cast<unsigned char>('a' + (i * 7 + i / 5) % 26)};
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST_CASE("find and rfind a single byte", "[find]") {
+  constexpr auto text = "GET /index.html HTTP/1.1\r\nHost: x\r\n\r\n"sv;
+  auto const bytes = cbyte_view{text};
+
+  REQUIRE(range3::find(bytes, std::byte{'\r'}) == text.find('\r'));
+  REQUIRE(range3::find(bytes, std::byte{'\r'}, 25) == text.find('\r', 25));
+  REQUIRE(range3::find(bytes, std::byte{'#'}) == npos);
+  REQUIRE(range3::find(bytes, std::byte{'G'}, text.size()) == npos);
+  REQUIRE(range3::rfind(bytes, std::byte{'\r'}) == text.rfind('\r'));
+  REQUIRE(range3::rfind(bytes, std::byte{'\r'}, 30) == text.rfind('\r', 30));
+  REQUIRE(range3::rfind(bytes, std::byte{'#'}) == npos);
+  REQUIRE(range3::rfind(cbyte_view{}, std::byte{'a'}) == npos);
+  REQUIRE(range3::find(cbyte_view{}, std::byte{'a'}) == npos);
+
+  SECTION("offsets compose with subspan") {
+    auto const eol = range3::find(bytes, std::byte{'\r'});
+    REQUIRE(range3::as_sv(bytes.first(eol)) == "GET /index.html HTTP/1.1");
+    REQUIRE(range3::as_sv(bytes.subspan(eol + 2, 7)) == "Host: x");
+  }
+}
+
+TEST_CASE("find matches a scalar reference on every length and offset",
+          "[find]") {
+  for (size_t size :
+       {0U, 1U, 15U, 16U, 17U, 31U, 32U, 33U, 63U, 64U, 65U, 130U, 257U}) {
+    auto const data = make_pattern(size);
+    auto const bytes = cbyte_view{data};
+    for (size_t target = 0; target <= size; ++target) {
+      auto copy = data;
+      if (target < size) {
+        copy[target] = std::byte{'#'};
+      }
+      auto const view = cbyte_view{copy};
+      auto const is_hash = [](std::byte b) { return b == std::byte{'#'}; };
+      for (size_t pos : {size_t{0}, target / 2, target, size}) {
+        REQUIRE(range3::find(view, std::byte{'#'}, pos)
+                == naive_find_if(view, pos, is_hash));
+        REQUIRE(range3::rfind(view, std::byte{'#'}, pos)
+                == naive_find_last_if(view, pos, is_hash));
+      }
+    }
+    REQUIRE(range3::find(bytes, std::byte{'#'}) == npos);
+  }
+}
+
+TEST_CASE("find_first_of and find_first_not_of", "[find]") {
+  constexpr auto text = "key = value ; other=1\n"sv;
+  auto const bytes = cbyte_view{text};
+  auto const delims = cbyte_view{"=;\n"sv};
+  auto const spaces = cbyte_view{" \t"sv};
+
+  REQUIRE(range3::find_first_of(bytes, delims) == text.find_first_of("=;\n"));
+  REQUIRE(range3::find_first_of(bytes, delims, 5)
+          == text.find_first_of("=;\n", 5));
+  REQUIRE(range3::find_first_not_of(bytes, spaces, 5)
+          == text.find_first_not_of(" \t", 5));
+  REQUIRE(range3::find_last_of(bytes, delims) == text.find_last_of("=;\n"));
+  REQUIRE(range3::find_last_not_of(bytes, cbyte_view{"\n"sv})
+          == text.find_last_not_of('\n'));
+  REQUIRE(range3::find_first_of(bytes, cbyte_view{}) == npos);
+  REQUIRE(range3::find_first_not_of(bytes, cbyte_view{}) == 0);
+
+  SECTION("small and large sets agree with a scalar reference") {
+    auto const data = make_pattern(300);
+    auto const view = cbyte_view{data};
+    for (std::string_view set : {"q"sv,
+                                 "xyz"sv,
+                                 "abcdefghijklmnop"sv,
+                                 "abcdefghijklmnopq"sv,
+                                 "bcdefghijklmnopqrstuvwxyz"sv}) {
+      auto const in_set = [set](std::byte b) {
+        return set.find(static_cast<char>(b)) != std::string_view::npos;
+      };
+      auto const not_in_set = [&](std::byte b) { return !in_set(b); };
+      for (size_t pos : {0U, 1U, 17U, 64U, 200U, 299U, 300U}) {
+        REQUIRE(range3::find_first_of(view, cbyte_view{set}, pos)
+                == naive_find_if(view, pos, in_set));
+        REQUIRE(range3::find_first_not_of(view, cbyte_view{set}, pos)
+                == naive_find_if(view, pos, not_in_set));
+        REQUIRE(range3::find_last_of(view, cbyte_view{set}, pos)
+                == naive_find_last_if(view, pos, in_set));
+        REQUIRE(range3::find_last_not_of(view, cbyte_view{set}, pos)
+                == naive_find_last_if(view, pos, not_in_set));
+      }
+    }
+  }
+}
+
+TEST_CASE("find a byte sequence", "[find]") {
+  constexpr auto text = "GET / HTTP/1.1\r\nHost: x\r\n\r\nbody"sv;
+  auto const bytes = cbyte_view{text};
+  for (std::string_view needle :
+       {"\r\n"sv, "\r\n\r\n"sv, "Host"sv, "y"sv, "body"sv, "bodyx"sv, ""sv}) {
+    for (size_t pos : {size_t{0}, size_t{5}, size_t{16}, text.size()}) {
+      REQUIRE(range3::find(bytes, cbyte_view{needle}, pos)
+              == text.find(needle, pos));
+    }
+  }
+  REQUIRE(range3::find(bytes, cbyte_view{""sv}, text.size() + 1) == npos);
+
+  SECTION("candidates are verified across register boundaries") {
+    for (size_t size : {2U, 17U, 33U, 64U, 65U, 100U, 257U}) {
+      // Needles of a repeated byte make every position a first/last byte
+      // candidate; the real match sits at each possible offset in turn.
+      for (size_t length : {2U, 3U, 16U, 40U}) {
+        if (length > size) {
+          continue;
+        }
+        for (size_t at = 0; at + length <= size; ++at) {
+          std::string hay(size, 'a');
+          std::string needle(length, 'a');
+          needle[length / 2] = 'b';
+          hay[at + (length / 2)] = 'b';
+          REQUIRE(range3::find(cbyte_view{hay}, cbyte_view{needle})
+                  == hay.find(needle));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("find on static extents", "[find]") {
+  std::array<char, 6> arr = {'a', 'b', ',', 'c', ',', 'd'};
+  auto const bytes = byte_span{arr};
+  STATIC_REQUIRE(decltype(bytes)::extent == 6);
+
+  REQUIRE(range3::find(bytes, std::byte{','}) == 2);
+  REQUIRE(range3::rfind(bytes, std::byte{','}) == 4);
+  REQUIRE(range3::find_first_of(bytes, bytes.first<2>()) == 0);
+  REQUIRE(range3::find_first_not_of(bytes, bytes.first<2>()) == 2);
+}
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 202207L  // C++26
+TEST_CASE("find in constant expressions", "[find]") {
+  static constexpr std::array<char, 6> arr = {'a', 'b', ',', 'c', ',', 'd'};
+  constexpr auto bytes = byte_span{arr};
+
+  STATIC_REQUIRE(range3::find(bytes, std::byte{','}) == 2);
+  STATIC_REQUIRE(range3::rfind(bytes, std::byte{','}) == 4);
+  STATIC_REQUIRE(range3::find(bytes, bytes.subspan<3, 2>()) == 3);
+  STATIC_REQUIRE(range3::find_first_of(bytes, bytes.first<2>()) == 0);
+  STATIC_REQUIRE(range3::find_first_not_of(bytes, bytes.first<2>()) == 2);
+}
+#endif
+
+// NOLINTEND(misc-const-correctness)
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/hash.hpp"
+
+using range3::byte_span;
+using range3::cbyte_view;
+using range3::hash64;
+using range3::hasher;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto make_input(size_t size) -> std::vector<std::byte> {
+  auto v = std::vector<std::byte>(size);
+  for (size_t i = 0; i < size; ++i) {
+    v[i] = std::byte{static_cast<unsigned char>((i * 131 + 7) & 0xFF)};
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST_CASE("hash64 distinguishes lengths, contents and seeds", "[hash]") {
+  auto const data = make_input(300);
+  auto const view = cbyte_view{data};
+
+  auto seen = std::set<std::uint64_t>{};
+  for (size_t len = 0; len <= view.size(); ++len) {
+    auto const h = hash64(view.first(len));
+    REQUIRE(h == hash64(view.first(len)));
+    seen.insert(h);
+  }
+  REQUIRE(seen.size() == view.size() + 1);
+
+  REQUIRE(hash64(view, 1) != hash64(view, 2));
+  REQUIRE(hash64(cbyte_view{"abc"sv}) != hash64(cbyte_view{"abd"sv}));
+  REQUIRE(hash64(cbyte_view{"abc"sv}) != hash64(cbyte_view{"cba"sv}));
+
+  SECTION("flipping any bit changes the hash") {
+    for (size_t len : {1U, 3U, 8U, 16U, 17U, 47U, 48U, 49U, 100U}) {
+      auto copy = std::vector<std::byte>(len);
+      std::copy_n(data.begin(), len, copy.begin());
+      auto const base = hash64(copy);
+      for (size_t i = 0; i < len; ++i) {
+        copy[i] ^= std::byte{0x01};
+        REQUIRE(hash64(copy) != base);
+        copy[i] ^= std::byte{0x01};
+      }
+    }
+  }
+}
+
+TEST_CASE("static extents hash like dynamic extents", "[hash]") {
+  std::array<std::byte, 4> k4{std::byte{1}, std::byte{2}, std::byte{3}};
+  std::array<std::uint64_t, 2> k16{0x0123456789ABCDEFULL, 42};
+  std::array<std::uint32_t, 10> k40{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::array<std::byte, 0> k0{};
+
+  REQUIRE(hash64(byte_span{k4}) == hash64(cbyte_view{byte_span{k4}}));
+  REQUIRE(hash64(byte_span{k16}, 9) == hash64(cbyte_view{byte_span{k16}}, 9));
+  REQUIRE(hash64(byte_span{k40}) == hash64(cbyte_view{byte_span{k40}}));
+  REQUIRE(hash64(byte_span{k0}) == hash64(cbyte_view{}));
+}
+
+TEST_CASE("streaming hasher matches the one-shot hash", "[hash]") {
+  auto const data = make_input(400);
+  auto const view = cbyte_view{data};
+
+  for (size_t len : {0U, 5U, 16U, 17U, 47U, 48U, 49U, 96U, 150U, 400U}) {
+    auto const expected = hash64(view.first(len), 77);
+    for (size_t chunk : {1U, 7U, 16U, 48U, 50U, 400U}) {
+      auto h = hasher{77};
+      for (size_t off = 0; off < len; off += chunk) {
+        h.update(view.subspan(off, std::min(chunk, len - off)));
+      }
+      REQUIRE(h.digest() == expected);
+    }
+  }
+
+  SECTION("empty updates are no-ops") {
+    auto h = hasher{};
+    h.update(cbyte_view{}).update(view.first(20)).update(cbyte_view{});
+    REQUIRE(h.digest() == hash64(view.first(20)));
+  }
+}
+
+TEST_CASE("std::hash supports heterogeneous lookup", "[hash]") {
+  auto const storage = std::string{"alpha beta gamma"};
+  auto const bytes = cbyte_view{storage};
+
+  auto map = std::unordered_map<cbyte_view,
+                                int,
+                                std::hash<cbyte_view>,
+                                range3::byte_span_equal>{};
+  map.emplace(bytes.first(5), 1);
+  map.emplace(bytes.subspan(6, 4), 2);
+  map.emplace(bytes.last(5), 3);
+
+  REQUIRE(map.size() == 3);
+  REQUIRE(map.find(cbyte_view{"beta"sv})->second == 2);
+
+  auto const hash = std::hash<cbyte_view>{};
+  auto const vec = std::vector<char>{'g', 'a', 'm', 'm', 'a'};
+  auto const span = std::span<const std::byte>{bytes.last(5).data(), 5};
+  REQUIRE(hash("alpha"sv) == hash(bytes.first(5)));
+  REQUIRE(hash(vec) == hash(bytes.last(5)));
+  REQUIRE(hash(span) == hash(bytes.last(5)));
+
+#if defined(__cpp_lib_generic_unordered_lookup)
+  REQUIRE(map.find("alpha"sv) != map.end());
+  REQUIRE(map.find(vec)->second == 3);
+  REQUIRE(map.find(span)->second == 3);
+  REQUIRE(map.find("delta"sv) == map.end());
+#endif
+
+  auto set = std::unordered_set<byte_span<const std::byte, 4>>{};
+  std::array<char, 4> key{'a', 'b', 'c', 'd'};
+  set.insert(byte_span<const std::byte, 4>{byte_span{key}});
+  REQUIRE(set.size() == 1);
+}
+
+// NOLINTEND(misc-const-correctness)
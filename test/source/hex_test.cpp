@@ -0,0 +1,94 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/hex.hpp"
+
+using range3::byte_errc;
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::hex_case;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto random_bytes(size_t count) -> std::vector<std::byte> {
+  std::mt19937 rng{static_cast<unsigned>(count)};
+  std::vector<std::byte> out(count);
+  for (auto& b : out) {
+    b = static_cast<std::byte>(rng());
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("hex_encode writes lower and upper case digits", "[hex]") {
+  auto const bytes = "\x00\x1f\xa0\xff"sv;
+  REQUIRE(range3::to_hex(cbyte_view{bytes}) == "001fa0ff");
+  REQUIRE(range3::to_hex(cbyte_view{bytes}, hex_case::upper) == "001FA0FF");
+  REQUIRE(range3::to_hex(cbyte_view{}).empty());
+
+  std::string out(range3::hex_encoded_size(bytes.size()), '\0');
+  REQUIRE(range3::hex_encode(cbyte_view{bytes}, byte_view{out}) == 8);
+  REQUIRE(out == "001fa0ff");
+}
+
+TEST_CASE("hex round-trips across kernel boundaries", "[hex]") {
+  for (size_t n : {0U, 1U, 15U, 16U, 31U, 32U, 33U, 64U, 100U, 1000U}) {
+    auto const bytes = random_bytes(n);
+    auto const lower = range3::to_hex(cbyte_view{bytes});
+    auto const upper = range3::to_hex(cbyte_view{bytes}, hex_case::upper);
+    REQUIRE(lower.size() == 2 * n);
+
+    std::string expected;
+    for (auto const b : bytes) {
+      expected += "0123456789abcdef"[std::to_integer<unsigned>(b) >> 4U];
+      expected += "0123456789abcdef"[std::to_integer<unsigned>(b) & 0xFU];
+    }
+    REQUIRE(lower == expected);
+
+    for (auto const& text : {lower, upper}) {
+      std::vector<std::byte> decoded(range3::hex_decoded_size(text.size()));
+      auto const r = range3::hex_decode(cbyte_view{text}, byte_view{decoded});
+      REQUIRE(r);
+      REQUIRE(r.size == n);
+      REQUIRE(r.offset == text.size());
+      REQUIRE(decoded == bytes);
+    }
+  }
+}
+
+TEST_CASE("hex_decode reports the first invalid character", "[hex]") {
+  auto const text = range3::to_hex(cbyte_view{random_bytes(100)});
+  std::vector<std::byte> decoded(100);
+  for (size_t at : {0U, 1U, 31U, 32U, 63U, 64U, 150U, 199U}) {
+    for (char bad : {'g', 'G', '/', ':', '@', '`', ' ', '\xff'}) {
+      auto corrupt = text;
+      corrupt[at] = bad;
+      auto const r =
+          range3::hex_decode(cbyte_view{corrupt}, byte_view{decoded});
+      REQUIRE(r.ec == byte_errc::invalid_encoding);
+      REQUIRE(r.offset == at);
+      REQUIRE(r.size == at / 2);
+    }
+  }
+}
+
+TEST_CASE("hex_decode reports an odd trailing digit", "[hex]") {
+  std::vector<std::byte> decoded(8);
+  auto const r = range3::hex_decode(cbyte_view{"abc"sv}, byte_view{decoded});
+  REQUIRE(r.ec == byte_errc::out_of_range);
+  REQUIRE(r.offset == 2);
+  REQUIRE(r.size == 1);
+  REQUIRE(decoded[0] == std::byte{0xAB});
+}
+
+// NOLINTEND(misc-const-correctness)
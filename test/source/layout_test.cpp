@@ -0,0 +1,126 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/endian.hpp"
+#include "byte_span/layout.hpp"
+
+using range3::be_field;
+using range3::byte_span;
+using range3::field;
+using range3::le_field;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+enum class kind : std::uint8_t { data = 1, ack = 2 };
+
+// A 64-byte record header
+namespace hdr {
+using magic = be_field<std::uint32_t, 0>;
+using version = le_field<std::uint16_t, 4>;
+using type = field<kind, 6>;
+using length = be_field<std::uint64_t, 8>;
+using ratio = le_field<double, 16>;
+using name = field<std::array<char, 8>, 24>;
+using record = range3::layout<64, magic, version, type, length, ratio, name>;
+}  // namespace hdr
+
+template <typename F, typename Span>
+concept gettable = requires(Span s) { range3::get<F>(s); };
+
+template <typename F, typename Span>
+concept settable =
+    requires(Span s) { range3::set<F>(s, typename F::value_type{}); };
+
+template <size_t Size, typename... Fields>
+concept valid_layout = requires { typename range3::layout<Size, Fields...>; };
+
+}  // namespace
+
+TEST_CASE("layout fields read and write in their byte order", "[layout]") {
+  std::array<std::byte, 64> storage{};
+  auto const bytes = byte_span{storage};
+
+  hdr::record::set<hdr::magic>(bytes, 0xCAFEF00DU);
+  hdr::record::set<hdr::version>(bytes, 3);
+  hdr::record::set<hdr::type>(bytes, kind::ack);
+  hdr::record::set<hdr::length>(bytes, 0x0102030405060708U);
+  hdr::record::set<hdr::ratio>(bytes, 0.5);
+  hdr::record::set<hdr::name>(bytes, {'r', 'e', 'c', 'o', 'r', 'd'});
+
+  REQUIRE(storage[0] == std::byte{0xCA});
+  REQUIRE(storage[3] == std::byte{0x0D});
+  REQUIRE(storage[4] == std::byte{3});
+  REQUIRE(storage[5] == std::byte{0});
+  REQUIRE(storage[8] == std::byte{0x01});
+  REQUIRE(storage[15] == std::byte{0x08});
+  REQUIRE(std::bit_cast<std::uint64_t>(
+              range3::load_le<double>(range3::cbyte_view{storage}, 16))
+          == std::bit_cast<std::uint64_t>(0.5));
+
+  auto const view = byte_span<const std::byte, 64>{bytes};
+  REQUIRE(hdr::record::get<hdr::magic>(view) == 0xCAFEF00DU);
+  REQUIRE(hdr::record::get<hdr::version>(view) == 3);
+  REQUIRE(hdr::record::get<hdr::type>(view) == kind::ack);
+  REQUIRE(hdr::record::get<hdr::length>(view) == 0x0102030405060708U);
+  REQUIRE(std::bit_cast<std::uint64_t>(hdr::record::get<hdr::ratio>(view))
+          == std::bit_cast<std::uint64_t>(0.5));
+  REQUIRE(std::string_view{hdr::record::get<hdr::name>(view).data()}
+          == "record");
+
+  auto const magic = range3::field_bytes<hdr::magic>(view);
+  STATIC_REQUIRE(decltype(magic)::extent == 4);
+  REQUIRE(magic.data() == view.data());
+  REQUIRE(range3::field_bytes<hdr::name>(view).data() == view.data() + 24);
+}
+
+TEST_CASE("fields are bounds-checked against the extent", "[layout]") {
+  using head = byte_span<const std::byte, 8>;
+  STATIC_REQUIRE(gettable<be_field<std::uint32_t, 4>, head>);
+  STATIC_REQUIRE_FALSE(gettable<be_field<std::uint32_t, 5>, head>);
+  STATIC_REQUIRE_FALSE(gettable<be_field<std::uint64_t, 8>, head>);
+  STATIC_REQUIRE_FALSE(gettable<be_field<std::uint16_t, 0>,
+                                range3::cbyte_view>);
+  STATIC_REQUIRE(settable<le_field<std::uint16_t, 6>,
+                          byte_span<std::byte, 8>>);
+  STATIC_REQUIRE_FALSE(settable<le_field<std::uint16_t, 6>, head>);
+
+  // Out-of-range and overlapping fields make the layout ill-formed.
+  STATIC_REQUIRE(valid_layout<8, be_field<std::uint32_t, 0>,
+                              be_field<std::uint32_t, 4>>);
+  STATIC_REQUIRE_FALSE(valid_layout<8, be_field<std::uint32_t, 0>,
+                                    be_field<std::uint32_t, 5>>);
+  STATIC_REQUIRE_FALSE(valid_layout<8, be_field<std::uint32_t, 0>,
+                                    be_field<std::uint16_t, 3>>);
+  STATIC_REQUIRE_FALSE(valid_layout<8, be_field<std::uint32_t, 2>,
+                                    be_field<std::uint16_t, 0>,
+                                    be_field<std::uint8_t, 5>>);
+  STATIC_REQUIRE(valid_layout<0>);
+
+  // A layout only accepts its own fields and its own size.
+  using pair = range3::layout<8, be_field<std::uint32_t, 0>>;
+  STATIC_REQUIRE(pair::contains<be_field<std::uint32_t, 0>>);
+  STATIC_REQUIRE_FALSE(pair::contains<le_field<std::uint32_t, 0>>);
+  STATIC_REQUIRE(pair::size == 8);
+}
+
+TEST_CASE("layouts in constant expressions", "[layout]") {
+  STATIC_REQUIRE([] {
+    std::array<std::byte, 64> storage{};
+    auto const bytes = byte_span{storage};
+    hdr::record::set<hdr::length>(bytes, 42);
+    hdr::record::set<hdr::type>(bytes, kind::data);
+    return hdr::record::get<hdr::length>(bytes) == 42
+        && storage[15] == std::byte{42}
+        && hdr::record::get<hdr::type>(bytes) == kind::data;
+  }());
+}
+
+// NOLINTEND(misc-const-correctness)
@@ -0,0 +1,160 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/mapped_file.hpp"
+
+using range3::map_advice;
+using range3::map_mode;
+using range3::mapped_file;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+// A file in the temporary directory, removed again on destruction.
+class temp_file {
+ public:
+  explicit temp_file(std::string_view contents)
+      : path_{std::filesystem::temp_directory_path()
+              / ("byte_span_mapped_file_test_" + std::to_string(::getpid())
+                 + "_" + std::to_string(counter++))} {
+    std::ofstream out{path_, std::ios::binary};
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  }
+  temp_file(const temp_file&) = delete;
+  auto operator=(const temp_file&) -> temp_file& = delete;
+  temp_file(temp_file&&) = delete;
+  auto operator=(temp_file&&) -> temp_file& = delete;
+  ~temp_file() { std::filesystem::remove(path_); }
+
+  [[nodiscard]]
+  auto path() const -> const std::filesystem::path& {
+    return path_;
+  }
+
+  [[nodiscard]]
+  auto read() const -> std::string {
+    std::string out(std::filesystem::file_size(path_), '\0');
+    std::ifstream in{path_, std::ios::binary};
+    in.read(out.data(), static_cast<std::streamsize>(out.size()));
+    return out;
+  }
+
+ private:
+  static inline int counter = 0;
+  std::filesystem::path path_;
+};
+
+auto pattern(size_t size) -> std::string {
+  std::string out(size, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<char>('a' + (i * 7 % 26));
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("mapped_file maps a whole file read-only", "[mapped_file]") {
+  auto const contents = pattern(10000);
+  temp_file file{contents};
+  mapped_file map{file.path()};
+  REQUIRE(map.is_open());
+  REQUIRE(map.mode() == map_mode::read_only);
+  REQUIRE(map.file_size() == contents.size());
+  REQUIRE(map.size() == contents.size());
+  REQUIRE(map.offset() == 0);
+  REQUIRE(range3::as_sv(map.bytes()) == contents);
+  REQUIRE(map.writable_bytes().empty());
+
+  REQUIRE_FALSE(map.advise(map_advice::sequential));
+  REQUIRE_FALSE(map.advise(map_advice::willneed, 5000, 100));
+}
+
+TEST_CASE("mapped_file maps windows at unaligned offsets", "[mapped_file]") {
+  auto const contents = pattern(3 * 4096 + 100);
+  temp_file file{contents};
+  mapped_file map{file.path(), map_mode::read_only, 5000, 3000};
+  REQUIRE(map.offset() == 5000);
+  REQUIRE(range3::as_sv(map.bytes()) == contents.substr(5000, 3000));
+
+  map.remap(4095, mapped_file::to_end);
+  REQUIRE(map.offset() == 4095);
+  REQUIRE(range3::as_sv(map.bytes()) == contents.substr(4095));
+  REQUIRE_FALSE(map.advise(map_advice::random, 1, 10));
+
+  map.remap(contents.size(), 10);
+  REQUIRE(map.bytes().empty());
+
+  std::error_code ec;
+  map.remap(contents.size() + 1, 10, ec);
+  REQUIRE(ec == std::errc::invalid_argument);
+}
+
+TEST_CASE("mapped_file writes through read_write maps", "[mapped_file]") {
+  temp_file file{pattern(8192)};
+  {
+    mapped_file map{file.path(), map_mode::read_write, 4000, 8};
+    auto bytes = map.writable_bytes();
+    std::ranges::fill(bytes, std::byte{'#'});
+    map.sync();
+  }
+  auto const contents = file.read();
+  REQUIRE(contents.substr(4000, 8) == "########");
+  REQUIRE(contents.substr(0, 4000) == pattern(8192).substr(0, 4000));
+}
+
+TEST_CASE("mapped_file moves and closes cleanly", "[mapped_file]") {
+  temp_file file{"hello"};
+  mapped_file a{file.path()};
+  auto const* data = a.bytes().data();
+
+  mapped_file b{std::move(a)};
+  REQUIRE_FALSE(a.is_open());  // NOLINT(bugprone-use-after-move)
+  REQUIRE(a.bytes().empty());
+  REQUIRE(b.bytes().data() == data);
+
+  mapped_file c;
+  c = std::move(b);
+  REQUIRE(range3::as_sv(c.bytes()) == "hello");
+  c.close();
+  REQUIRE_FALSE(c.is_open());
+  REQUIRE(c.bytes().empty());
+}
+
+TEST_CASE("mapped_file handles empty files", "[mapped_file]") {
+  temp_file file{""};
+  mapped_file map{file.path()};
+  REQUIRE(map.is_open());
+  REQUIRE(map.bytes().empty());
+  REQUIRE_FALSE(map.advise(map_advice::sequential));
+  map.sync();
+}
+
+TEST_CASE("mapped_file reports open errors", "[mapped_file]") {
+  auto const missing =
+      std::filesystem::temp_directory_path() / "byte_span_no_such_file";
+  std::error_code ec;
+  mapped_file map{missing, map_mode::read_only, ec};
+  REQUIRE(ec == std::errc::no_such_file_or_directory);
+  REQUIRE_FALSE(map.is_open());
+
+  REQUIRE_THROWS_AS(mapped_file{missing}, std::system_error);
+}
+
+// NOLINTEND(misc-const-correctness)
+
+#endif
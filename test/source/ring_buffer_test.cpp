@@ -0,0 +1,232 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/ring_buffer.hpp"
+
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::mpsc_ring_buffer;
+using range3::ring_mode;
+using range3::spsc_ring_buffer;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto text_of(range3::ring_segments<const std::byte> r) -> std::string {
+  std::string out{range3::as_sv(r.first)};
+  out += range3::as_sv(r.second);
+  return out;
+}
+
+auto mirroring_available() -> bool {
+  std::error_code ec;
+  spsc_ring_buffer const probe{1, ring_mode::mirrored, ec};
+  return !ec;
+}
+
+}  // namespace
+
+TEST_CASE("ring buffer capacity is a power of two", "[ring_buffer]") {
+  REQUIRE(spsc_ring_buffer{1000}.capacity() == 1024);
+  REQUIRE(spsc_ring_buffer{64}.capacity() == 64);
+  REQUIRE(mpsc_ring_buffer{3}.capacity() == 4);
+
+  REQUIRE_THROWS_AS(spsc_ring_buffer{0}, std::system_error);
+  std::error_code ec;
+  mpsc_ring_buffer const bad{0, ring_mode::plain, ec};
+  REQUIRE(ec == std::errc::invalid_argument);
+}
+
+TEST_CASE("spsc_ring_buffer hands out wrapped regions", "[ring_buffer]") {
+  spsc_ring_buffer ring{8};
+  REQUIRE(ring.empty());
+  REQUIRE(ring.peek().empty());
+
+  auto w = ring.reserve(6);
+  REQUIRE(w.size() == 6);
+  REQUIRE(w.second.empty());
+  std::memcpy(w.first.data(), "abcdef", 6);
+  ring.commit(4);  // only part of the reservation is published
+  REQUIRE(ring.size() == 4);
+
+  auto r = ring.peek();
+  REQUIRE(text_of(r) == "abcd");
+  ring.release(3);
+  REQUIRE(text_of(ring.peek()) == "d");
+
+  // 7 bytes free now, wrapping past the end of the storage.
+  w = ring.reserve(100);
+  REQUIRE(w.size() == 7);
+  REQUIRE(w.first.size() == 4);
+  REQUIRE(w.second.size() == 3);
+  REQUIRE(w.second.data() + 4 == w.first.data());
+  REQUIRE(ring.write(cbyte_view{"0123456789"sv}) == 7);
+  REQUIRE(ring.reserve(1).empty());
+
+  r = ring.peek(6);
+  REQUIRE(r.size() == 6);
+  REQUIRE(text_of(r) == "d01234");
+  REQUIRE(r.second.size() == 1);
+
+  std::array<char, 16> out{};
+  REQUIRE(ring.read(byte_view{out}) == 8);
+  REQUIRE(std::string_view{out.data(), 8} == "d0123456");
+  REQUIRE(ring.empty());
+}
+
+TEST_CASE("mirrored ring buffers are always contiguous", "[ring_buffer]") {
+  if (!mirroring_available()) {
+    return;  // no shared memory here
+  }
+  spsc_ring_buffer ring{100, ring_mode::mirrored};
+  REQUIRE(ring.mode() == ring_mode::mirrored);
+  auto const capacity = ring.capacity();
+  REQUIRE(capacity >= 4096);
+
+  std::vector<std::byte> filler(capacity - 3);
+  REQUIRE(ring.write(cbyte_view{filler}) == filler.size());
+  ring.release(ring.peek().size());
+
+  auto const w = ring.reserve(8);
+  REQUIRE(w.size() == 8);
+  REQUIRE(w.second.empty());
+  std::memcpy(w.first.data(), "wrapping", 8);
+  ring.commit(8);
+
+  auto const r = ring.peek();
+  REQUIRE(r.second.empty());
+  REQUIRE(range3::as_sv(r.first) == "wrapping");
+  ring.release(8);
+
+  // The five bytes written past the end are at the start of the storage.
+  auto const again = ring.reserve(capacity);
+  REQUIRE(range3::as_sv(again.first.last(5)) == "pping");
+}
+
+TEST_CASE("spsc_ring_buffer streams between threads", "[ring_buffer]") {
+  constexpr size_t total = 1 << 20;
+  for (auto const mode : {ring_mode::plain, ring_mode::mirrored}) {
+    if (mode == ring_mode::mirrored && !mirroring_available()) {
+      continue;
+    }
+    spsc_ring_buffer ring{4096, mode};
+
+    std::thread producer{[&] {
+      size_t sent = 0;
+      size_t step = 1;
+      while (sent < total) {
+        auto const w = ring.reserve(std::min(step, total - sent));
+        for (auto const part : {w.first, w.second}) {
+          for (auto& b : part) {
+            b = static_cast<std::byte>(sent++ * 31);
+          }
+        }
+        ring.commit(w.size());
+        step = step % 1000 + 7;
+      }
+    }};
+
+    size_t received = 0;
+    size_t errors = 0;
+    while (received < total) {
+      auto const r = ring.peek(received % 300 + 1);
+      for (auto const part : {r.first, r.second}) {
+        for (auto const b : part) {
+          errors += b != static_cast<std::byte>(received++ * 31) ? 1U : 0U;
+        }
+      }
+      ring.release(r.size());
+    }
+    producer.join();
+    REQUIRE(errors == 0);
+    REQUIRE(ring.empty());
+  }
+}
+
+TEST_CASE("mpsc_ring_buffer keeps records from many producers intact",
+          "[ring_buffer]") {
+  constexpr unsigned producers = 4;
+  constexpr std::uint32_t per_producer = 20000;
+  // Every claim and release is one 8-byte record, so free space stays a
+  // multiple of the record size and claims are never partial.
+  struct record {
+    std::uint32_t producer;
+    std::uint32_t sequence;
+  };
+  mpsc_ring_buffer ring{1024};
+
+  std::vector<std::thread> threads;
+  for (unsigned p = 0; p < producers; ++p) {
+    threads.emplace_back([&ring, p] {
+      for (std::uint32_t i = 0; i < per_producer;) {
+        record const rec{p, i};
+        if (ring.write(cbyte_view{&rec, 1}) == sizeof(rec)) {
+          ++i;
+        }
+      }
+    });
+  }
+
+  // size() from a thread that is neither producer nor consumer
+  std::atomic<bool> done{false};
+  size_t oversized = 0;
+  std::thread observer{[&] {
+    while (!done.load(std::memory_order_relaxed)) {
+      oversized += ring.size() > ring.capacity() ? 1U : 0U;
+    }
+  }};
+
+  std::array<std::uint32_t, producers> next{};
+  size_t out_of_order = 0;
+  for (size_t n = 0; n < producers * per_producer;) {
+    record rec{};
+    if (ring.read(byte_view{&rec, 1}) == 0) {
+      continue;
+    }
+    out_of_order += rec.sequence != next[rec.producer]++ ? 1U : 0U;
+    ++n;
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  done = true;
+  observer.join();
+  REQUIRE(oversized == 0);
+  REQUIRE(out_of_order == 0);
+  REQUIRE(next == std::array<std::uint32_t, producers>{
+                      per_producer, per_producer, per_producer, per_producer});
+  REQUIRE(ring.empty());
+}
+
+TEST_CASE("mpsc_ring_buffer reservations commit in claim order",
+          "[ring_buffer]") {
+  mpsc_ring_buffer ring{16};
+  auto const a = ring.reserve(4);
+  auto const b = ring.reserve(4);
+  REQUIRE(a.size() == 4);
+  REQUIRE(b.first.data() == a.first.data() + 4);
+
+  std::memcpy(b.first.data(), "bbbb", 4);
+  std::thread late{[&] { ring.commit(b); }};  // waits for `a`
+  std::memcpy(a.first.data(), "aaaa", 4);
+  ring.commit(a);
+  late.join();
+  REQUIRE(text_of(ring.peek()) == "aaaabbbb");
+
+  ring.commit(mpsc_ring_buffer::reservation{});  // empty: no-op
+  REQUIRE(ring.reserve(100).size() == 8);
+}
+
+// NOLINTEND(misc-const-correctness)
@@ -0,0 +1,212 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/scatter_gather.hpp"
+
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::const_io_buffers;
+using range3::io_buffers;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto joined(const const_io_buffers& seq) -> std::string {
+  std::string out;
+  for (auto const bytes : seq) {
+    out += range3::as_sv(bytes);
+  }
+  return out;
+}
+
+template <typename B>
+concept sequence_of = requires { typename range3::byte_span_sequence<B>; };
+
+// Both ends of a pipe, closed on destruction.
+struct pipe_fds {
+  std::array<int, 2> fd{-1, -1};
+
+  pipe_fds() { REQUIRE(::pipe(fd.data()) == 0); }
+  pipe_fds(const pipe_fds&) = delete;
+  auto operator=(const pipe_fds&) -> pipe_fds& = delete;
+  pipe_fds(pipe_fds&&) = delete;
+  auto operator=(pipe_fds&&) -> pipe_fds& = delete;
+  ~pipe_fds() {
+    ::close(fd[0]);
+    ::close(fd[1]);
+  }
+};
+
+}  // namespace
+
+TEST_CASE("byte_span_sequence holds views as iovecs", "[scatter_gather]") {
+  STATIC_REQUIRE(std::random_access_iterator<const_io_buffers::iterator>);
+  STATIC_REQUIRE(sequence_of<const std::byte>);
+  STATIC_REQUIRE_FALSE(sequence_of<char>);
+  STATIC_REQUIRE_FALSE(sequence_of<const unsigned char>);
+
+  auto const header = "HTTP/1.1 200 OK\r\n\r\n"sv;
+  auto const body = "hello"sv;
+  const_io_buffers seq{cbyte_view{header}, cbyte_view{body}};
+  REQUIRE(seq.size() == 2);
+  REQUIRE(seq.total_size() == header.size() + body.size());
+
+  auto const vecs = seq.iovecs();
+  REQUIRE(vecs.size() == 2);
+  REQUIRE(vecs[0].iov_base == header.data());
+  REQUIRE(vecs[1].iov_len == body.size());
+  REQUIRE(range3::from_iovec(vecs[1]).data()
+          == cbyte_view{body}.data());
+
+  const_io_buffers copy{vecs};
+  REQUIRE(joined(copy) == joined(seq));
+}
+
+TEST_CASE("byte_span_sequence consumes from the front", "[scatter_gather]") {
+  const_io_buffers seq{cbyte_view{"abc"sv}, cbyte_view{""sv},
+                       cbyte_view{"defg"sv}, cbyte_view{"h"sv}};
+  seq.consume(2);
+  REQUIRE(joined(seq) == "cdefgh");
+  REQUIRE(seq.size() == 4);
+  seq.consume(1);
+  REQUIRE(seq.size() == 2);
+  REQUIRE(seq.front().size() == 4);
+  seq.consume(4);
+  REQUIRE(joined(seq) == "h");
+  seq.consume(1);
+  REQUIRE(seq.empty());
+  REQUIRE(seq.total_size() == 0);
+}
+
+TEST_CASE("byte_span_sequence spills past its inline capacity",
+          "[scatter_gather]") {
+  std::string const text = "0123456789abcdefghijklmnopqrstuvwxyz";
+  range3::byte_span_sequence<const std::byte, 4> seq;
+  for (size_t i = 0; i < text.size(); ++i) {
+    seq.push_back(cbyte_view{text}.subspan(i, 1));
+    if (i % 5 == 4) {
+      seq.consume(1);
+    }
+  }
+  std::string out;
+  for (auto const bytes : seq) {
+    out += range3::as_sv(bytes);
+  }
+  REQUIRE(seq.size() == text.size() - 7);
+  REQUIRE(out == text.substr(7));
+}
+
+TEST_CASE("byte_span_sequence moves leave the source empty and usable",
+          "[scatter_gather]") {
+  std::string const text = "0123456789abcdefghij";
+  auto const fill = [&](const_io_buffers& seq) {
+    for (size_t i = 0; i < text.size(); ++i) {
+      seq.push_back(cbyte_view{text}.subspan(i, 1));
+    }
+  };
+
+  const_io_buffers spilled;
+  fill(spilled);
+  auto moved = std::move(spilled);
+  REQUIRE(joined(moved) == text);
+  // NOLINTBEGIN(bugprone-use-after-move, hicpp-invalid-access-moved)
+  REQUIRE(spilled.empty());
+  REQUIRE(spilled.total_size() == 0);
+  REQUIRE(spilled.iovecs().empty());
+  REQUIRE(joined(spilled).empty());
+  fill(spilled);
+  REQUIRE(joined(spilled) == text);
+
+  const_io_buffers small{cbyte_view{"ab"sv}};
+  small = std::move(spilled);
+  REQUIRE(joined(small) == text);
+  REQUIRE(spilled.empty());
+  spilled.push_back(cbyte_view{"cd"sv});
+  REQUIRE(joined(spilled) == "cd");
+  // NOLINTEND(bugprone-use-after-move, hicpp-invalid-access-moved)
+
+  moved = std::move(small);
+  REQUIRE(joined(moved) == text);
+  moved.consume(3);
+  REQUIRE(moved.total_size() == text.size() - 3);
+}
+
+TEST_CASE("writev and readv advance through partial transfers",
+          "[scatter_gather]") {
+  pipe_fds p;
+  std::string const body(1000, 'x');
+  const_io_buffers out{cbyte_view{"head|"sv}, cbyte_view{body},
+                       cbyte_view{"|tail"sv}};
+  auto const total = out.total_size();
+
+  std::error_code ec;
+  REQUIRE(range3::write_all(p.fd[1], out, ec) == total);
+  REQUIRE_FALSE(ec);
+  REQUIRE(out.empty());
+
+  std::array<char, 3> a{};
+  std::vector<char> b(total);
+  io_buffers in{byte_view{a}, byte_view{b}};
+  size_t read = 0;
+  while (read < total) {
+    read += range3::readv(p.fd[0], in, ec);
+    REQUIRE_FALSE(ec);
+  }
+  REQUIRE(std::string_view{a.data(), 3} == "hea");
+  REQUIRE(std::string_view{b.data(), total - 3}
+          == "d|" + body + "|tail");
+  REQUIRE(in.total_size() == 3);
+}
+
+TEST_CASE("pwritev and preadv use explicit offsets", "[scatter_gather]") {
+  char path[] = "/tmp/byte_span_scatter_gather_XXXXXX";
+  int const fd = ::mkstemp(path);
+  REQUIRE(fd != -1);
+  ::unlink(path);
+
+  std::error_code ec;
+  const_io_buffers out{cbyte_view{"abc"sv}, cbyte_view{"def"sv}};
+  REQUIRE(range3::pwritev(fd, out, 10, ec) == 6);
+
+  std::array<char, 4> a{};
+  std::array<char, 2> b{};
+  io_buffers in{byte_view{a}, byte_view{b}};
+  REQUIRE(range3::preadv(fd, in, 10, ec) == 6);
+  REQUIRE(std::string_view{a.data(), 4} == "abcd");
+  REQUIRE(std::string_view{b.data(), 2} == "ef");
+
+#if defined(__linux__) && defined(RWF_NOWAIT)
+  const_io_buffers more{cbyte_view{"XY"sv}};
+  REQUIRE(range3::pwritev2(fd, more, 11, 0, ec) == 2);
+  std::array<char, 4> c{};
+  io_buffers again{byte_view{c}};
+  REQUIRE(range3::preadv2(fd, again, 10, 0, ec) == 4);
+  REQUIRE(std::string_view{c.data(), 4} == "aXYd");
+#endif
+
+  io_buffers bad{byte_view{a}};
+  REQUIRE(range3::readv(-1, bad, ec) == 0);
+  REQUIRE(ec == std::errc::bad_file_descriptor);
+  REQUIRE(bad.total_size() == a.size());
+  ::close(fd);
+}
+
+// NOLINTEND(misc-const-correctness)
+
+#endif
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/split.hpp"
+
+using range3::cbyte_view;
+using range3::split_mode;
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto tokens(std::ranges::input_range auto&& view)
+    -> std::vector<std::string_view> {
+  std::vector<std::string_view> out;
+  for (cbyte_view const token : view) {
+    out.push_back(range3::as_sv(token));
+  }
+  return out;
+}
+
+// Reference split for a single-byte delimiter, std::views::split semantics
+auto naive_split(std::string_view text, char delimiter)
+    -> std::vector<std::string_view> {
+  std::vector<std::string_view> out;
+  if (text.empty()) {
+    return out;
+  }
+  size_t pos = 0;
+  for (;;) {
+    auto const at = text.find(delimiter, pos);
+    out.push_back(text.substr(pos, at - pos));
+    if (at == std::string_view::npos) {
+      return out;
+    }
+    pos = at + 1;
+  }
+}
+
+using list = std::vector<std::string_view>;
+
+}  // namespace
+
+TEST_CASE("split_view is a borrowed forward view", "[split]") {
+  using view = decltype(range3::split(cbyte_view{}, std::byte{}));
+  STATIC_REQUIRE(std::ranges::view<view>);
+  STATIC_REQUIRE(std::ranges::forward_range<view>);
+  STATIC_REQUIRE(std::ranges::borrowed_range<view>);
+  STATIC_REQUIRE(std::same_as<std::ranges::range_value_t<view>, cbyte_view>);
+  STATIC_REQUIRE(std::ranges::view<decltype(range3::split_any(
+                     cbyte_view{}, cbyte_view{}))>);
+
+  auto const text = "a,b"sv;
+  auto it = std::ranges::begin(range3::split(cbyte_view{text}, std::byte{','}));
+  REQUIRE(range3::as_sv(*it) == "a");
+  REQUIRE(range3::as_sv(*++it) == "b");
+
+  auto const v = range3::split(cbyte_view{text}, std::byte{','});
+  REQUIRE(std::ranges::distance(v) == 2);
+  REQUIRE(range3::as_sv(v.front()) == "a");
+  REQUIRE_FALSE(v.empty());
+  REQUIRE(v.base().size() == 3);
+  REQUIRE(std::ranges::next(v.begin()) != v.begin());
+}
+
+TEST_CASE("split on a single byte", "[split]") {
+  auto const split = [](std::string_view text) {
+    return tokens(range3::split(cbyte_view{text}, std::byte{'\n'}));
+  };
+  REQUIRE(split(""sv).empty());
+  REQUIRE(split("one"sv) == list{"one"});
+  REQUIRE(split("a\nbb\nccc"sv) == list{"a", "bb", "ccc"});
+  REQUIRE(split("a\n"sv) == list{"a", ""});
+  REQUIRE(split("\n\n"sv) == list{"", "", ""});
+
+  SECTION("agrees with a reference on every length and position") {
+    for (size_t size : {1U, 15U, 16U, 17U, 32U, 33U, 64U, 65U, 130U}) {
+      for (size_t stride : {1U, 2U, 7U, 40U, 200U}) {
+        std::string text(size, 'x');
+        for (size_t i = stride - 1; i < size; i += stride) {
+          text[i] = '\n';
+        }
+        REQUIRE(split(text) == naive_split(text, '\n'));
+      }
+    }
+  }
+}
+
+TEST_CASE("split keeping delimiters", "[split]") {
+  auto const lines = [](std::string_view text) {
+    return tokens(range3::split(
+        cbyte_view{text}, std::byte{'\n'}, split_mode::keep_delimiter));
+  };
+  REQUIRE(lines(""sv).empty());
+  REQUIRE(lines("a\nb\n"sv) == list{"a\n", "b\n"});
+  REQUIRE(lines("a\nb"sv) == list{"a\n", "b"});
+  REQUIRE(lines("\n\n"sv) == list{"\n", "\n"});
+
+  auto const text = "GET / HTTP/1.1\r\nHost: x\r\n\r\n"sv;
+  auto const headers = tokens(range3::split(
+      cbyte_view{text}, cbyte_view{"\r\n"sv}, split_mode::keep_delimiter));
+  REQUIRE(headers == list{"GET / HTTP/1.1\r\n", "Host: x\r\n", "\r\n"});
+
+  std::string joined;
+  for (auto const t : headers) {
+    joined += t;
+  }
+  REQUIRE(joined == text);
+}
+
+TEST_CASE("split on a byte sequence", "[split]") {
+  auto const split = [](std::string_view text, std::string_view sep) {
+    return tokens(range3::split(cbyte_view{text}, cbyte_view{sep}));
+  };
+  REQUIRE(split("a\r\nb\r\n\r\nc"sv, "\r\n"sv) == list{"a", "b", "", "c"});
+  REQUIRE(split("a--b"sv, "---"sv) == list{"a--b"});
+  REQUIRE(split("aaaa"sv, "aa"sv) == list{"", "", ""});
+  REQUIRE(split("x::y::"sv, "::"sv) == list{"x", "y", ""});
+
+  std::string big;
+  for (int i = 0; i < 100; ++i) {
+    big += std::to_string(i) + "<sep>";
+  }
+  auto const parts = split(big, "<sep>"sv);
+  REQUIRE(parts.size() == 101);
+  REQUIRE(parts[42] == "42");
+  REQUIRE(parts.back().empty());
+}
+
+TEST_CASE("split on any byte of a set", "[split]") {
+  auto const text = "key=value; other = 1\tend"sv;
+  REQUIRE(tokens(range3::split_any(cbyte_view{text}, cbyte_view{" =;\t"sv}))
+          == list{"key", "value", "", "other", "", "", "1", "end"});
+
+  // Sets too large for vector compares use the table fallback.
+  auto const large = cbyte_view{"0123456789abcdefghij"sv};
+  REQUIRE(tokens(range3::split_any(cbyte_view{"x1y22z"sv}, large))
+          == list{"x", "y", "", "z"});
+  REQUIRE(tokens(range3::split_any(
+              cbyte_view{"x1y"sv}, large, split_mode::keep_delimiter))
+          == list{"x1", "y"});
+}
+
+TEST_CASE("split composes with range adaptors", "[split]") {
+  auto const text = "3\n\n1\n4\n\n1\n5"sv;
+  auto non_empty = range3::split(cbyte_view{text}, std::byte{'\n'})
+                 | std::views::filter([](cbyte_view t) { return !t.empty(); });
+  REQUIRE(tokens(non_empty) == list{"3", "1", "4", "1", "5"});
+  REQUIRE(std::ranges::count_if(
+              range3::split(cbyte_view{text}, std::byte{'\n'}),
+              &cbyte_view::empty)
+          == 2);
+}
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 202207L  // C++26
+TEST_CASE("split in constant expressions", "[split]") {
+  STATIC_REQUIRE([] {
+    auto const v = range3::split(cbyte_view{"a,bc,,d"sv}, std::byte{','});
+    return std::ranges::distance(v);
+  }() == 4);
+}
+#endif
+
+// NOLINTEND(misc-const-correctness)
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/unaligned.hpp"
+
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::unaligned_span;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+struct record {
+  std::uint16_t tag;
+  std::uint8_t flags;
+  std::uint8_t pad;
+  std::uint32_t value;
+
+  friend auto operator==(const record&, const record&) -> bool = default;
+};
+
+// Bytes 0, 1, 2, ... so every offset is recognizable.
+template <size_t N>
+constexpr auto iota_bytes() -> std::array<std::byte, N> {
+  std::array<std::byte, N> out{};
+  for (size_t i = 0; i < N; ++i) {
+    out[i] = static_cast<std::byte>(i);
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("load and store work at any offset", "[unaligned]") {
+  alignas(8) auto storage = iota_bytes<32>();
+  cbyte_view const bytes{storage};
+
+  for (size_t offset = 0; offset < 8; ++offset) {
+    auto const v = range3::load<std::uint32_t>(bytes, offset);
+    std::uint32_t expected = 0;
+    std::memcpy(&expected, storage.data() + offset, sizeof(expected));
+    REQUIRE(v == expected);
+  }
+
+  std::array<std::byte, 17> out{};
+  record const r{.tag = 0x1234, .flags = 7, .pad = 0, .value = 0xDEADBEEF};
+  range3::store(byte_view{out}, r, 5);
+  REQUIRE(range3::load<record>(cbyte_view{out}, 5) == r);
+  REQUIRE(out[4] == std::byte{0});
+  REQUIRE(out[5 + sizeof(record)] == std::byte{0});
+
+  range3::store(byte_view{out}, 1.5, 1);
+  REQUIRE(std::bit_cast<std::uint64_t>(range3::load<double>(cbyte_view{out}, 1))
+          == std::bit_cast<std::uint64_t>(1.5));
+}
+
+TEST_CASE("unaligned_span reads packed elements", "[unaligned]") {
+  using span_type = unaligned_span<const std::uint16_t>;
+  STATIC_REQUIRE(std::ranges::random_access_range<span_type>);
+  STATIC_REQUIRE(std::ranges::sized_range<span_type>);
+  STATIC_REQUIRE(std::ranges::view<span_type>);
+  STATIC_REQUIRE(std::ranges::borrowed_range<span_type>);
+  STATIC_REQUIRE(
+      std::is_same_v<std::ranges::range_reference_t<span_type>, std::uint16_t>);
+  STATIC_REQUIRE_FALSE(std::is_convertible_v<cbyte_view, span_type>);
+  STATIC_REQUIRE_FALSE(
+      std::is_constructible_v<unaligned_span<std::uint16_t>, cbyte_view>);
+
+  auto const storage = iota_bytes<21>();
+  span_type const words{cbyte_view{storage}.subspan(1, 20)};
+  REQUIRE(words.size() == 10);
+  REQUIRE(words.size_bytes() == 20);
+  REQUIRE(words.bytes().data() == storage.data() + 1);
+
+  for (size_t i = 0; i < words.size(); ++i) {
+    auto const lo = (2 * i) + 1;
+    REQUIRE(words[i] == range3::load<std::uint16_t>(cbyte_view{storage}, lo));
+  }
+  REQUIRE(words.front() == words[0]);
+  REQUIRE(words.back() == words[9]);
+
+  std::vector<std::uint16_t> copied(words.begin(), words.end());
+  REQUIRE(copied.size() == 10);
+  REQUIRE(copied[3] == words[3]);
+  REQUIRE(std::ranges::equal(words | std::views::reverse,
+                             copied | std::views::reverse));
+
+  auto const mid = words.subspan(2, 3);
+  REQUIRE(mid.size() == 3);
+  REQUIRE(mid[0] == words[2]);
+  REQUIRE(words.first(4).back() == words[3]);
+  REQUIRE(words.last(2).front() == words[8]);
+  REQUIRE(words.subspan(10).empty());
+
+  auto it = words.begin();
+  it += 4;
+  REQUIRE(it - words.begin() == 4);
+  REQUIRE(*it == words[4]);
+  REQUIRE(it[1] == words[5]);
+  REQUIRE(words.end() - it == 6);
+  REQUIRE(it < words.end());
+}
+
+TEST_CASE("unaligned_span writes through proxies", "[unaligned]") {
+  std::array<std::byte, 13> storage{};
+  unaligned_span<std::uint32_t> words{byte_view{storage}.subspan(1)};
+  REQUIRE(words.size() == 3);
+
+  words[0] = 0x01020304U;
+  words[1] = words[0];
+  std::uint32_t const read = words[1];
+  REQUIRE(read == 0x01020304U);
+  REQUIRE(storage[0] == std::byte{0});
+
+  std::ranges::fill(words, 7U);
+  REQUIRE(std::ranges::count(words, 7U) == 3);
+
+  std::array<std::uint32_t, 3> const src{10, 20, 30};
+  std::ranges::copy(src, words.begin());
+  unaligned_span<const std::uint32_t> const view = words;
+  REQUIRE(std::ranges::equal(view, src));
+  REQUIRE(std::accumulate(view.begin(), view.end(), 0U) == 60);
+}
+
+TEST_CASE("copy_as moves whole elements", "[unaligned]") {
+  auto const storage = iota_bytes<19>();
+  cbyte_view const bytes = cbyte_view{storage}.subspan(3);
+
+  std::array<std::uint32_t, 8> out{};
+  // 16 bytes hold four elements.
+  REQUIRE(range3::copy_as<std::uint32_t>(bytes, out) == 4);
+  for (size_t i = 0; i < 4; ++i) {
+    REQUIRE(out[i] == range3::load<std::uint32_t>(bytes, i * 4));
+  }
+  REQUIRE(out[4] == 0);
+
+  // A partial element at the end is left alone; so is output overflow.
+  REQUIRE(range3::copy_as<std::uint32_t>(bytes.first(7), out) == 1);
+  std::array<std::uint16_t, 2> small{};
+  REQUIRE(range3::copy_as<std::uint16_t>(bytes, small) == 2);
+  REQUIRE(small[1] == range3::load<std::uint16_t>(bytes, 2));
+  REQUIRE(range3::copy_as<std::uint16_t>(cbyte_view{}, small) == 0);
+}
+
+TEST_CASE("unaligned access works in constant expressions", "[unaligned]") {
+  STATIC_REQUIRE([] {
+    auto const s = iota_bytes<9>();
+    return range3::load<std::uint8_t>(cbyte_view{s}, 3);
+  }() == 3);
+
+  constexpr auto words = [] {
+    auto const s = iota_bytes<9>();
+    std::array<std::uint16_t, 4> out{};
+    range3::copy_as<std::uint16_t>(cbyte_view{s}.subspan(1), out);
+    return out;
+  }();
+  if constexpr (std::endian::native == std::endian::little) {
+    STATIC_REQUIRE(words[0] == 0x0201);
+    STATIC_REQUIRE(words[3] == 0x0807);
+  }
+
+  constexpr auto sum = [] {
+    auto s = iota_bytes<9>();
+    unaligned_span<std::uint16_t> w{byte_view{s}.subspan(1)};
+    w[0] = w[3];
+    unaligned_span<const std::uint16_t> const r = w;
+    return static_cast<unsigned>(r[0] == r[3]) + r.size();
+  }();
+  STATIC_REQUIRE(sum == 5);
+}
+
+// NOLINTEND(misc-const-correctness)
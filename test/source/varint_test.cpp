@@ -0,0 +1,268 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "byte_span/byte_span.hpp"
+#include "byte_span/varint.hpp"
+
+using range3::byte_errc;
+using range3::byte_view;
+using range3::cbyte_view;
+using range3::max_varint_size;
+
+// NOLINTBEGIN(misc-const-correctness)
+
+namespace {
+
+auto bytes_of(std::initializer_list<unsigned> values)
+    -> std::vector<std::byte> {
+  std::vector<std::byte> out;
+  for (auto const v : values) {
+    out.push_back(static_cast<std::byte>(v));
+  }
+  return out;
+}
+
+// Mix of lengths with runs of single-byte values, so both the widening and
+// the gathering paths of the batch decoder are taken.
+template <typename T>
+auto sample_values(size_t count) -> std::vector<T> {
+  std::mt19937_64 rng{count};
+  std::vector<T> values(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto const bits = static_cast<unsigned>(rng() % 72);
+    auto v = rng();
+    if (i % 97 < 40) {
+      v &= 0x3FU;
+    } else if (bits < 64) {
+      v &= (std::uint64_t{2} << bits) - 1;
+    }
+    values[i] = static_cast<T>(v);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE("zigzag interleaves signed values", "[varint]") {
+  STATIC_REQUIRE(range3::zigzag_encode(std::int32_t{0}) == 0U);
+  STATIC_REQUIRE(range3::zigzag_encode(std::int32_t{-1}) == 1U);
+  STATIC_REQUIRE(range3::zigzag_encode(std::int32_t{1}) == 2U);
+  STATIC_REQUIRE(range3::zigzag_encode(std::int32_t{-2}) == 3U);
+  STATIC_REQUIRE(range3::zigzag_encode(std::numeric_limits<std::int64_t>::min())
+                 == std::numeric_limits<std::uint64_t>::max());
+  STATIC_REQUIRE(range3::zigzag_decode(std::uint8_t{255}) == -128);
+  STATIC_REQUIRE(range3::zigzag_decode(std::uint64_t{4}) == 2);
+
+  for (std::int16_t v = -300; v < 300; ++v) {
+    REQUIRE(range3::zigzag_decode(range3::zigzag_encode(v)) == v);
+  }
+}
+
+TEST_CASE("varint single values round-trip", "[varint]") {
+  STATIC_REQUIRE(max_varint_size<std::uint8_t> == 2);
+  STATIC_REQUIRE(max_varint_size<std::uint32_t> == 5);
+  STATIC_REQUIRE(max_varint_size<std::int64_t> == 10);
+
+  REQUIRE(range3::varint_size(0U) == 1);
+  REQUIRE(range3::varint_size(127U) == 1);
+  REQUIRE(range3::varint_size(128U) == 2);
+  REQUIRE(range3::varint_size(std::int32_t{-64}) == 1);
+  REQUIRE(range3::varint_size(std::int32_t{64}) == 2);
+  REQUIRE(range3::varint_size(~std::uint64_t{0}) == 10);
+
+  std::array<std::byte, 10> buf{};
+  REQUIRE(range3::encode_varint(byte_view{buf}, std::uint32_t{300}) == 2);
+  REQUIRE(buf[0] == std::byte{0xAC});
+  REQUIRE(buf[1] == std::byte{0x02});
+
+  auto const r = range3::decode_varint<std::uint32_t>(cbyte_view{buf});
+  REQUIRE(r);
+  REQUIRE(r.value == 300);
+  REQUIRE(r.size == 2);
+
+  for (auto const v : sample_values<std::uint64_t>(500)) {
+    auto const n = range3::encode_varint(byte_view{buf}, v);
+    REQUIRE(n == range3::varint_size(v));
+    auto const d = range3::decode_varint<std::uint64_t>(cbyte_view{buf});
+    REQUIRE(d.value == v);
+    REQUIRE(d.size == n);
+  }
+  for (auto const v : sample_values<std::int64_t>(500)) {
+    auto const n = range3::encode_varint(byte_view{buf}, v);
+    auto const d =
+        range3::decode_varint<std::int64_t>(cbyte_view{buf}.first(n));
+    REQUIRE(d.value == v);
+  }
+}
+
+TEST_CASE("encode_varint reports a short output", "[varint]") {
+  std::array<std::byte, 2> buf{std::byte{0xEE}, std::byte{0xEE}};
+  REQUIRE(range3::encode_varint(byte_view{buf}, std::uint32_t{1U << 14U}) == 0);
+  REQUIRE(buf[0] == std::byte{0xEE});
+  REQUIRE(range3::encode_varint(byte_view{buf}, std::uint32_t{1U << 13U}) == 2);
+}
+
+TEST_CASE("varint encoders leave the bytes after the encoding alone",
+          "[varint]") {
+  constexpr auto fill = std::byte{0xEE};
+  for (unsigned bits = 0; bits <= 64; ++bits) {
+    auto const v = bits == 64 ? ~std::uint64_t{0}
+                              : (std::uint64_t{1} << bits) - 1;
+    std::array<std::byte, 32> buf{};
+    buf.fill(fill);
+    auto const n = range3::encode_varint(byte_view{buf}, v);
+    REQUIRE(n == range3::varint_size(v));
+    for (size_t i = n; i < buf.size(); ++i) {
+      REQUIRE(buf[i] == fill);
+    }
+  }
+
+  // Short and long batches, and one that stops at a value that does not fit
+  for (size_t count : {1U, 7U, 8U, 9U, 40U}) {
+    auto const values = sample_values<std::uint64_t>(count);
+    std::vector<std::byte> buf(count * max_varint_size<std::uint64_t> + 16,
+                               fill);
+    auto const r = range3::encode_varints(std::span{values}, byte_view{buf});
+    REQUIRE(r.count == count);
+    for (size_t i = r.size; i < buf.size(); ++i) {
+      REQUIRE(buf[i] == fill);
+    }
+
+    std::vector<std::byte> small(r.size - 1, fill);
+    auto const cut = range3::encode_varints(std::span{values},
+                                            byte_view{small}.first(r.size / 2));
+    REQUIRE(cut.ec == byte_errc::out_of_range);
+    for (size_t i = cut.size; i < small.size(); ++i) {
+      REQUIRE(small[i] == fill);
+    }
+  }
+}
+
+TEST_CASE("decode_varint rejects malformed input", "[varint]") {
+  auto const truncated = bytes_of({0x80, 0x80});
+  REQUIRE(range3::decode_varint<std::uint64_t>(cbyte_view{truncated}).ec
+          == byte_errc::out_of_range);
+  REQUIRE(range3::decode_varint<std::uint64_t>(cbyte_view{}).ec
+          == byte_errc::out_of_range);
+
+  auto const too_long = bytes_of({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01});
+  REQUIRE(range3::decode_varint<std::uint32_t>(cbyte_view{too_long}).ec
+          == byte_errc::invalid_encoding);
+  REQUIRE(range3::decode_varint<std::uint64_t>(cbyte_view{too_long}));
+
+  auto const overflow = bytes_of({0xFF, 0xFF, 0xFF, 0xFF, 0x1F});
+  REQUIRE(range3::decode_varint<std::uint32_t>(cbyte_view{overflow}).ec
+          == byte_errc::invalid_encoding);
+  auto const max32 = bytes_of({0xFF, 0xFF, 0xFF, 0xFF, 0x0F});
+  REQUIRE(range3::decode_varint<std::uint32_t>(cbyte_view{max32}).value
+          == 0xFFFFFFFFU);
+
+  // Redundant continuation bytes are accepted within the maximum length.
+  auto const padded = bytes_of({0x81, 0x80, 0x00});
+  auto const r = range3::decode_varint<std::uint16_t>(cbyte_view{padded});
+  REQUIRE(r.value == 1);
+  REQUIRE(r.size == 3);
+}
+
+TEMPLATE_TEST_CASE("varint batches round-trip",
+                   "[varint]",
+                   std::uint64_t,
+                   std::int64_t,
+                   std::uint32_t,
+                   std::int32_t,
+                   std::uint16_t) {
+  for (size_t count : {0U, 1U, 7U, 40U, 1000U}) {
+    auto const values = sample_values<TestType>(count);
+    std::vector<std::byte> encoded(count * max_varint_size<TestType>);
+    auto const e =
+        range3::encode_varints(std::span{values}, byte_view{encoded});
+    REQUIRE(e);
+    REQUIRE(e.count == count);
+    encoded.resize(e.size);
+
+    std::vector<TestType> decoded(count);
+    auto const d =
+        range3::decode_varints(cbyte_view{encoded}, std::span{decoded});
+    REQUIRE(d);
+    REQUIRE(d.count == count);
+    REQUIRE(d.size == encoded.size());
+    REQUIRE(decoded == values);
+  }
+}
+
+TEST_CASE("decode_varints composes with subspan", "[varint]") {
+  auto const values = sample_values<std::uint64_t>(300);
+  std::vector<std::byte> encoded(values.size() * 10);
+  auto const e = range3::encode_varints(std::span{values}, byte_view{encoded});
+  auto input = cbyte_view{encoded}.first(e.size);
+
+  std::vector<std::uint64_t> decoded;
+  std::array<std::uint64_t, 23> chunk{};
+  while (!input.empty()) {
+    auto const r = range3::decode_varints(input, std::span{chunk});
+    REQUIRE(r);
+    decoded.insert(decoded.end(), chunk.begin(), chunk.begin() + r.count);
+    input = input.subspan(r.size);
+  }
+  REQUIRE(decoded == values);
+}
+
+TEST_CASE("decode_varints stops at partial and malformed values", "[varint]") {
+  std::vector<std::byte> encoded(64, std::byte{0x05});
+  encoded.push_back(std::byte{0x80});
+  std::array<std::uint32_t, 100> out{};
+
+  auto r = range3::decode_varints(cbyte_view{encoded}, std::span{out});
+  REQUIRE(r.ec == byte_errc::out_of_range);
+  REQUIRE(r.count == 64);
+  REQUIRE(r.size == 64);
+
+  // A run of continuation bytes longer than max_varint_size
+  encoded.insert(encoded.end(), 40, std::byte{0x80});
+  encoded.insert(encoded.end(), 40, std::byte{0x00});
+  r = range3::decode_varints(cbyte_view{encoded}, std::span{out});
+  REQUIRE(r.ec == byte_errc::invalid_encoding);
+  REQUIRE(r.count == 64);
+  REQUIRE(r.size == 64);
+
+  // Overflowing the element type mid-batch
+  std::vector<std::byte> wide(64, std::byte{0x01});
+  auto const big = bytes_of({0xFF, 0xFF, 0xFF, 0xFF, 0x7F});
+  wide.insert(wide.begin() + 10, big.begin(), big.end());
+  r = range3::decode_varints(cbyte_view{wide}, std::span{out});
+  REQUIRE(r.ec == byte_errc::invalid_encoding);
+  REQUIRE(r.count == 10);
+  REQUIRE(r.size == 10);
+}
+
+TEST_CASE("encode_varints stops before a value that does not fit",
+          "[varint]") {
+  std::array<std::uint32_t, 3> values{1, 300, 5};
+  std::array<std::byte, 2> small{};
+  auto const r = range3::encode_varints(std::span{values}, byte_view{small});
+  REQUIRE(r.ec == byte_errc::out_of_range);
+  REQUIRE(r.count == 1);
+  REQUIRE(r.size == 1);
+}
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 202207L  // C++26
+TEST_CASE("varint codec is constexpr", "[varint][constexpr]") {
+  constexpr auto roundtrip = [] {
+    std::array<std::byte, 10> buf{};
+    auto const n =
+        range3::encode_varint(byte_view{buf}, std::int64_t{-1234567});
+    return range3::decode_varint<std::int64_t>(cbyte_view{buf}.first(n)).value;
+  };
+  STATIC_REQUIRE(roundtrip() == -1234567);
+}
+#endif
+
+// NOLINTEND(misc-const-correctness)